@@ -0,0 +1,90 @@
+/*
+ * Loopback bus tests: complete output path (BusManager routing, dirty detection, brightness)
+ * is exercised without LED hardware, frames are checked as recorded by the bus.
+ * Run on a connected ESP32 with: pio test -e esp32dev_test
+ */
+#include <Arduino.h>
+#include <unity.h>
+#include "wled.h"
+
+#define TEST_LEDS 4
+
+static const uint32_t frameA[TEST_LEDS] = { 0x00FF0000, 0x0000FF00, 0x000000FF, 0x00402010 };
+static const uint32_t frameB[TEST_LEDS] = { 0x00FFFFFF, 0x00000000, 0x00804020, 0x00010203 };
+
+static BusLoopback *addLoopback(uint8_t depth, uint8_t type = TYPE_LOOPBACK_RGB) {
+  uint8_t pins[5] = { depth, 255, 255, 255, 255 };
+  BusConfig bc(type, pins, 0, TEST_LEDS);
+  TEST_ASSERT_EQUAL(1, BusManager::add(bc));
+  BusLoopback *bus = BusManager::getLoopback();
+  TEST_ASSERT_NOT_NULL(bus);
+  TEST_ASSERT_EQUAL(depth, bus->getDepth());
+  BusManager::setBrightness(255);
+  return bus;
+}
+
+static void showFrame(const uint32_t *frame) {
+  BusManager::setPixels(0, frame, TEST_LEDS);
+  BusManager::show();
+}
+
+void setUp() {}
+
+void tearDown() {
+  BusManager::removeAll();
+}
+
+// painted frame is recorded unchanged at full brightness
+void test_loopback_records_frame() {
+  BusLoopback *bus = addLoopback(2);
+  showFrame(frameA);
+  TEST_ASSERT_EQUAL_UINT32(1, bus->getFramesShown());
+  TEST_ASSERT_NOT_NULL(bus->getFrame());
+  TEST_ASSERT_EQUAL_HEX32_ARRAY(frameA, bus->getFrame(), TEST_LEDS);
+  TEST_ASSERT_NULL(bus->getFrame(1)); // only one frame shown so far
+}
+
+// brightness is applied to recorded frame the same way as color_fade() does
+void test_loopback_applies_brightness() {
+  BusLoopback *bus = addLoopback(2);
+  BusManager::setBrightness(128);
+  showFrame(frameA);
+  const uint32_t expected[TEST_LEDS] = { 0x00800000, 0x00008000, 0x00000080, 0x00201008 };
+  TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, bus->getFrame(), TEST_LEDS);
+}
+
+// unchanged frames are not transmitted again (dirty detection), changed ones are kept in a ring buffer
+void test_loopback_skips_unchanged_frames() {
+  BusLoopback *bus = addLoopback(2);
+  showFrame(frameA);
+  showFrame(frameA);
+  TEST_ASSERT_EQUAL_UINT32(1, bus->getFramesShown());
+  showFrame(frameB);
+  TEST_ASSERT_EQUAL_UINT32(2, bus->getFramesShown());
+  TEST_ASSERT_EQUAL_HEX32_ARRAY(frameB, bus->getFrame(0), TEST_LEDS);
+  TEST_ASSERT_EQUAL_HEX32_ARRAY(frameA, bus->getFrame(1), TEST_LEDS);
+  showFrame(frameA); // overwrites oldest slot
+  TEST_ASSERT_EQUAL_UINT32(2, bus->getFramesAvailable());
+  TEST_ASSERT_EQUAL_HEX32_ARRAY(frameA, bus->getFrame(0), TEST_LEDS);
+  TEST_ASSERT_EQUAL_HEX32_ARRAY(frameB, bus->getFrame(1), TEST_LEDS);
+}
+
+// memory estimate of a configuration matches memory used by created bus
+void test_loopback_mem_usage() {
+  uint8_t pins[5] = { 3, 255, 255, 255, 255 };
+  BusConfig bc(TYPE_LOOPBACK_RGB, pins, 0, TEST_LEDS);
+  BusLoopback *bus = addLoopback(3);
+  TEST_ASSERT_EQUAL(bus->getBusSize(), bc.memUsage());
+}
+
+void setup() {
+  delay(2000); // boards without USB-serial reset need time for the test runner to connect
+  UNITY_BEGIN();
+  RUN_TEST(test_loopback_records_frame);
+  RUN_TEST(test_loopback_applies_brightness);
+  RUN_TEST(test_loopback_skips_unchanged_frames);
+  RUN_TEST(test_loopback_mem_usage);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+# Converts a WLED ledmap JSON file (ledmap.json, ledmap1.json, ...) into the binary
+# ledmap format (ledmap.bin, ledmap1.bin, ...) which loads considerably faster.
+#
+# Binary layout (all values little endian):
+#   "LMAP" magic, uint8 version (1), uint8 name length, uint16 width, uint16 height,
+#   uint16 entry count, 4 reserved bytes, name (not null terminated), count x uint16 index
+# Negative (or out of range) indices are stored as 0xFFFF (no LED).
+#
+# usage: ledmap2bin.py ledmap1.json [ledmap1.bin]
+
+import json
+import struct
+import sys
+
+MAGIC = b"LMAP"
+VERSION = 1
+MAX_INDEX = 16384
+
+def convert(src, dst):
+    with open(src, "r") as f:
+        ledmap = json.load(f)
+    entries = ledmap.get("map", [])
+    if len(entries) > 0xFFFF:
+        raise ValueError("ledmap has too many entries")
+    name = ledmap.get("n", "").encode("utf-8")[:32]
+    width = int(ledmap.get("width", 0))
+    height = int(ledmap.get("height", 0))
+    with open(dst, "wb") as f:
+        f.write(MAGIC)
+        f.write(struct.pack("<BBHHH4x", VERSION, len(name), width, height, len(entries)))
+        f.write(name)
+        f.write(struct.pack("<%dH" % len(entries), *[i if 0 <= i <= MAX_INDEX else 0xFFFF for i in entries]))
+    print("%s: %d entries, %dx%d -> %s" % (src, len(entries), width, height, dst))
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("usage: %s ledmap.json [ledmap.bin]" % sys.argv[0])
+        sys.exit(1)
+    source = sys.argv[1]
+    target = sys.argv[2] if len(sys.argv) > 2 else (source[:-5] if source.endswith(".json") else source) + ".bin"
+    convert(source, target)
@@ -4441,10 +4441,10 @@ static const char _data_FX_MODE_WASHING_MACHINE[] PROGMEM = "Washing Machine@!,!
 
 /*
   Image effect
-  Draws a .gif image from filesystem on the matrix/strip
+  Draws a .gif image or plays a .fseq sequence from filesystem on the matrix/strip
 */
 uint16_t mode_image(void) {
-  #ifndef WLED_ENABLE_GIF
+  #if !defined(WLED_ENABLE_GIF) && !defined(WLED_ENABLE_FSEQ)
   return mode_static();
   #else
   renderImageToSegment(SEGMENT);
@@ -5083,114 +5083,296 @@ static const char _data_FX_MODE_2DFRIZZLES[] PROGMEM = "Frizzles@X frequency,Y f
 ///////////////////////////////////////////
 //   2D Cellular Automata Game of life   //
 ///////////////////////////////////////////
-typedef struct ColorCount {
-  CRGB color;
-  int8_t count;
-} colorCount;
+// random mask with each bit set with probability of 1/128
+static uint32_t randomMask128() {
+  uint32_t mask = hw_random();
+  for (unsigned i = 0; i < 6; i++) mask &= hw_random();
+  return mask;
+}
+
+// cellular automata helpers: lay out n equally sized bit grids in segment data
+static uint32_t *allocateGrids(unsigned n, unsigned cols, unsigned rows, unsigned extra = 0) {
+  const unsigned gridSize = caWords(cols) * rows * sizeof(uint32_t);
+  if (!SEGENV.allocateData(n * gridSize + extra)) return nullptr;
+  return reinterpret_cast<uint32_t*>(SEGENV.data);
+}
+
+// remembers grid hashes of last generations, returns true if grid repeats one of them (still life or oscillator)
+#define CA_HASH_HISTORY 4
+static bool caRepeats(uint32_t *history, const uint32_t *grid, size_t words) {
+  const uint32_t hash = caHash(grid, words);
+  bool repetition = false;
+  for (unsigned i = 0; i < CA_HASH_HISTORY; i++) repetition |= (history[i] == hash);
+  history[SEGENV.aux0] = hash;
+  ++SEGENV.aux0 %= CA_HASH_HISTORY;
+  return repetition;
+}
 
 uint16_t mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https://natureofcode.com/book/chapter-7-cellular-automata/ and https://github.com/DougHaber/nlife-color
   if (!strip.isMatrix || !SEGMENT.is2D()) return mode_static(); // not a 2D set-up
 
-  const int cols = SEG_W;
-  const int rows = SEG_H;
-  const auto XY = [&](int x, int y) { return (x%cols) + (y%rows) * cols; };
-  const unsigned dataSize = sizeof(CRGB) * SEGMENT.length();  // using width*height prevents reallocation if mirroring is enabled
-  const int crcBufferLen = 2; //(SEGMENT.width() + SEGMENT.height())*71/100; // roughly sqrt(2)/2 for better repetition detection (Ewowi)
+  const unsigned cols  = SEG_W;
+  const unsigned rows  = SEG_H;
+  const unsigned words = caWords(cols);
+  const unsigned gridWords = words * rows;
+  // two bit grids (current & next generation), palette index of each cell and hash history for repetition detection
+  uint32_t *grids = allocateGrids(2, cols, rows, cols * rows + CA_HASH_HISTORY * sizeof(uint32_t));
+  if (!grids) return mode_static(); //allocation failed
+  uint32_t *hashes = grids + 2 * gridWords;
+  uint8_t  *colors = reinterpret_cast<uint8_t*>(hashes + CA_HASH_HISTORY);
+  uint32_t *cells  = grids + (SEGENV.aux1 & 1) * gridWords;
+  uint32_t *next   = grids + (~SEGENV.aux1 & 1) * gridWords;
 
-  if (!SEGENV.allocateData(dataSize + sizeof(uint16_t)*crcBufferLen)) return mode_static(); //allocation failed
-  CRGB *prevLeds = reinterpret_cast<CRGB*>(SEGENV.data);
-  uint16_t *crcBuffer = reinterpret_cast<uint16_t*>(SEGENV.data + dataSize); 
-
-  CRGB backgroundColor = SEGCOLOR(1);
+  const uint32_t bgc = SEGCOLOR(1);
 
   if (SEGENV.call == 0 || strip.now - SEGMENT.step > 3000) {
     SEGENV.step = strip.now;
     SEGENV.aux0 = 0;
-
-    //give the leds random state and colors (based on intensity, colors from palette or all posible colors are chosen)
-    for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) {
-      unsigned state = hw_random8()%2;
-      if (state == 0)
-        SEGMENT.setPixelColorXY(x,y, backgroundColor);
-      else
-        SEGMENT.setPixelColorXY(x,y, SEGMENT.color_from_palette(hw_random8(), false, PALETTE_SOLID_WRAP, 255));
-    }
-
-    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) prevLeds[XY(x,y)] = CRGB::Black;
-    memset(crcBuffer, 0, sizeof(uint16_t)*crcBufferLen);
+    //give the leds random state and colors (colors from palette or all posible colors are chosen)
+    for (unsigned i = 0; i < gridWords; i++) cells[i] = hw_random() & caValidMask(cols, i % words);
+    for (unsigned i = 0; i < cols * rows; i++) colors[i] = hw_random8();
+    memset(hashes, 0, CA_HASH_HISTORY * sizeof(uint32_t));
   } else if (strip.now - SEGENV.step < FRAMETIME_FIXED * (uint32_t)map(SEGMENT.speed,0,255,64,4)) {
     // update only when appropriate time passes (in 42 FPS slots)
     return FRAMETIME;
+  } else {
+    // calculate next generation, 32 cells at once
+    for (unsigned y = 0; y < rows; y++) for (unsigned i = 0; i < words; i++) {
+      uint32_t c[4];
+      caCountNeighbours(cells, cols, rows, y, i, c);
+      const uint32_t alive = cells[y * words + i];
+      const uint32_t valid = caValidMask(cols, i);
+      uint32_t births    = ~alive & caCountIn(c, 1<<3) & valid & ~randomMask128(); // Reproduction (a bit of randomness to avoid "gliders")
+      uint32_t mutations = ~alive & caCountIn(c, 1<<2) & valid &  randomMask128(); // Mutation
+      next[y * words + i] = (alive & caCountIn(c, 1<<2 | 1<<3)) | births | mutations; // Loneliness & Overpopulation kill
+      // colors of new cells (a small fraction of all cells)
+      while (births) {
+        const unsigned x = (i << 5) + __builtin_ctz(births);
+        births &= births - 1;
+        // find dominant color of (living) neighbours and assign it to a cell
+        uint8_t  neighbourColors[8];
+        unsigned found = 0;
+        for (int dy = -1; dy <= 1; dy++) for (int dx = -1; dx <= 1; dx++) {
+          const unsigned xx = (x + cols + dx) % cols, yy = (y + rows + dy) % rows;
+          if ((dx || dy) && caGetCell(cells, cols, xx, yy)) neighbourColors[found++] = colors[xx + yy * cols];
+        }
+        unsigned dominant = 0, dominantCount = 0;
+        for (unsigned k = 0; k < found; k++) {
+          unsigned count = 0;
+          for (unsigned l = 0; l < found; l++) count += (neighbourColors[l] == neighbourColors[k]);
+          if (count > dominantCount) { dominantCount = count; dominant = k; }
+        }
+        colors[x + y * cols] = neighbourColors[dominant];
+      }
+      while (mutations) {
+        const unsigned x = (i << 5) + __builtin_ctz(mutations);
+        mutations &= mutations - 1;
+        colors[x + y * cols] = hw_random8();
+      }
+    }
+    SEGENV.aux1 ^= 1;
+    std::swap(cells, next);
+
+    // same hash would mean image did not change or was repeating itself
+    if (!caRepeats(hashes, cells, gridWords)) SEGENV.step = strip.now; //if no repetition avoid reset
   }
 
-  //copy previous leds (save previous generation)
-  //NOTE: using lossy getPixelColor() is a benefit as endlessly repeating patterns will eventually fade out causing a reset
-  for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) prevLeds[XY(x,y)] = SEGMENT.getPixelColorXY(x,y);
-
-  //calculate new leds
-  for (int x = 0; x < cols; x++) for (int y = 0; y < rows; y++) {
-
-    colorCount colorsCount[9]; // count the different colors in the 3*3 matrix
-    for (int i=0; i<9; i++) colorsCount[i] = {backgroundColor, 0}; // init colorsCount
-
-    // iterate through neighbors and count them and their different colors
-    int neighbors = 0;
-    for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) { // iterate through 3*3 matrix
-      if (i==0 && j==0) continue; // ignore itself
-      // wrap around segment
-      int xx = x+i, yy = y+j;
-      if (x+i < 0) xx = cols-1; else if (x+i >= cols) xx = 0;
-      if (y+j < 0) yy = rows-1; else if (y+j >= rows) yy = 0;
-
-      unsigned xy = XY(xx, yy); // previous cell xy to check
-      // count different neighbours and colors
-      if (prevLeds[xy] != backgroundColor) {
-        neighbors++;
-        bool colorFound = false;
-        int k;
-        for (k=0; k<9 && colorsCount[k].count != 0; k++)
-          if (colorsCount[k].color == prevLeds[xy]) {
-            colorsCount[k].count++;
-            colorFound = true;
-          }
-        if (!colorFound) colorsCount[k] = {prevLeds[xy], 1}; //add new color found in the array
-      }
-    } // i,j
-
-    // Rules of Life
-    uint32_t col = uint32_t(prevLeds[XY(x,y)]) & 0x00FFFFFF;  // uint32_t operator returns RGBA, we want RGBW -> cut off "alpha" byte
-    uint32_t bgc = RGBW32(backgroundColor.r, backgroundColor.g, backgroundColor.b, 0);
-    if      ((col != bgc) && (neighbors <  2)) SEGMENT.setPixelColorXY(x,y, bgc); // Loneliness
-    else if ((col != bgc) && (neighbors >  3)) SEGMENT.setPixelColorXY(x,y, bgc); // Overpopulation
-    else if ((col == bgc) && (neighbors == 3)) {                                  // Reproduction
-      // find dominant color and assign it to a cell
-      colorCount dominantColorCount = {backgroundColor, 0};
-      for (int i=0; i<9 && colorsCount[i].count != 0; i++)
-        if (colorsCount[i].count > dominantColorCount.count) dominantColorCount = colorsCount[i];
-      // assign the dominant color w/ a bit of randomness to avoid "gliders"
-      if (dominantColorCount.count > 0 && hw_random8(128)) SEGMENT.setPixelColorXY(x,y, dominantColorCount.color);
-    } else if ((col == bgc) && (neighbors == 2) && !hw_random8(128)) {               // Mutation
-      SEGMENT.setPixelColorXY(x,y, SEGMENT.color_from_palette(hw_random8(), false, PALETTE_SOLID_WRAP, 255));
-    }
-    // else do nothing!
-  } //x,y
-
-  // calculate CRC16 of leds
-  uint16_t crc = crc16((const unsigned char*)prevLeds, dataSize);
-  // check if we had same CRC and reset if needed
-  bool repetition = false;
-  for (int i=0; i<crcBufferLen && !repetition; i++) repetition = (crc == crcBuffer[i]); // (Ewowi)
-  // same CRC would mean image did not change or was repeating itself
-  if (!repetition) SEGENV.step = strip.now; //if no repetition avoid reset
-  // remember CRCs across frames
-  crcBuffer[SEGENV.aux0] = crc;
-  ++SEGENV.aux0 %= crcBufferLen;
+  for (unsigned y = 0; y < rows; y++) for (unsigned x = 0; x < cols; x++) {
+    SEGMENT.setPixelColorXY(x, y, caGetCell(cells, cols, x, y) ? SEGMENT.color_from_palette(colors[x + y * cols], false, PALETTE_SOLID_WRAP, 255) : bgc);
+  }
 
   return FRAMETIME;
 } // mode_2Dgameoflife()
 static const char _data_FX_MODE_2DGAMEOFLIFE[] PROGMEM = "Game Of Life@!;!,!;!;2";
 
 
+/////////////////////////
+//   2D Brian's Brain  //
+/////////////////////////
+// cells are off, firing or dying: off cell with exactly 2 firing neighbours fires, firing cell starts dying, dying cell turns off
+uint16_t mode_2Dbriansbrain(void) {
+  if (!strip.isMatrix || !SEGMENT.is2D()) return mode_static(); // not a 2D set-up
+
+  const unsigned cols  = SEG_W;
+  const unsigned rows  = SEG_H;
+  const unsigned words = caWords(cols);
+  const unsigned gridWords = words * rows;
+  // firing & dying grids for current and next generation, hash history
+  uint32_t *grids = allocateGrids(4, cols, rows, CA_HASH_HISTORY * sizeof(uint32_t));
+  if (!grids) return mode_static(); //allocation failed
+  uint32_t *hashes = grids + 4 * gridWords;
+  uint32_t *firing = grids + (SEGENV.aux1 & 1) * 2 * gridWords;
+  uint32_t *dying  = firing + gridWords;
+  uint32_t *nextFiring = grids + (~SEGENV.aux1 & 1) * 2 * gridWords;
+  uint32_t *nextDying  = nextFiring + gridWords;
+
+  if (SEGENV.call == 0 || strip.now - SEGMENT.step > 3000) {
+    SEGENV.step = strip.now;
+    SEGENV.aux0 = 0;
+    // random seed, density depends on intensity
+    for (unsigned i = 0; i < gridWords; i++) {
+      uint32_t seed = 0;
+      for (unsigned b = 0; b < 32; b++) seed |= uint32_t(hw_random8() < SEGMENT.intensity / 2) << b;
+      firing[i] = seed & caValidMask(cols, i % words);
+      dying[i]  = 0;
+    }
+    memset(hashes, 0, CA_HASH_HISTORY * sizeof(uint32_t));
+  } else if (strip.now - SEGENV.step < FRAMETIME_FIXED * (uint32_t)map(SEGMENT.speed,0,255,64,1)) {
+    return FRAMETIME;
+  } else {
+    uint32_t active = 0;
+    for (unsigned y = 0; y < rows; y++) for (unsigned i = 0; i < words; i++) {
+      uint32_t c[4];
+      caCountNeighbours(firing, cols, rows, y, i, c);
+      const unsigned k = y * words + i;
+      nextFiring[k] = ~firing[k] & ~dying[k] & caCountIn(c, 1<<2) & caValidMask(cols, i);
+      nextDying[k]  = firing[k];
+      active |= nextFiring[k];
+    }
+    SEGENV.aux1 ^= 1;
+    std::swap(firing, nextFiring);
+    std::swap(dying, nextDying);
+    // reset 3s after all activity ceased or pattern started repeating
+    if (!caRepeats(hashes, firing, gridWords) && active) SEGENV.step = strip.now;
+  }
+
+  const uint32_t bgc = SEGCOLOR(1);
+  for (unsigned y = 0; y < rows; y++) for (unsigned x = 0; x < cols; x++) {
+    uint32_t color = bgc;
+    if      (caGetCell(firing, cols, x, y)) color = SEGMENT.color_from_palette(x * 255 / cols, false, PALETTE_SOLID_WRAP, 0);
+    else if (caGetCell(dying,  cols, x, y)) color = SEGMENT.color_from_palette(x * 255 / cols, false, PALETTE_SOLID_WRAP, 0, 64);
+    SEGMENT.setPixelColorXY(x, y, color);
+  }
+
+  return FRAMETIME;
+} // mode_2Dbriansbrain()
+static const char _data_FX_MODE_2DBRIANSBRAIN[] PROGMEM = "Brian's Brain@!,Density;,!;!;2;ix=128";
+
+
+/////////////////////////
+//     2D Wireworld    //
+/////////////////////////
+// conductors carry electrons: head becomes tail, tail becomes conductor, conductor becomes head if 1 or 2 neighbours are heads
+// a random circuit of rectangular loops (each with an electron) is generated, crossing loops create interesting patterns
+uint16_t mode_2Dwireworld(void) {
+  if (!strip.isMatrix || !SEGMENT.is2D()) return mode_static(); // not a 2D set-up
+
+  const unsigned cols  = SEG_W;
+  const unsigned rows  = SEG_H;
+  const unsigned words = caWords(cols);
+  const unsigned gridWords = words * rows;
+  // head, tail & conductor grids for current and next generation, hash history
+  uint32_t *grids = allocateGrids(6, cols, rows, CA_HASH_HISTORY * sizeof(uint32_t));
+  if (!grids) return mode_static(); //allocation failed
+  uint32_t *hashes = grids + 6 * gridWords;
+  uint32_t *head = grids + (SEGENV.aux1 & 1) * 3 * gridWords;
+  uint32_t *tail = head + gridWords;
+  uint32_t *wire = tail + gridWords;
+  uint32_t *nextHead = grids + (~SEGENV.aux1 & 1) * 3 * gridWords;
+  uint32_t *nextTail = nextHead + gridWords;
+  uint32_t *nextWire = nextTail + gridWords;
+
+  if (SEGENV.call == 0 || strip.now - SEGMENT.step > 3000) {
+    SEGENV.step = strip.now;
+    SEGENV.aux0 = 0;
+    memset(grids, 0, 6 * gridWords * sizeof(uint32_t));
+    // loops: number depends on intensity
+    const unsigned loops = 1 + SEGMENT.intensity / 32;
+    for (unsigned l = 0; l < loops && cols > 3 && rows > 3; l++) {
+      const unsigned x0 = hw_random16(cols - 3), y0 = hw_random16(rows - 3);
+      const unsigned x1 = x0 + 2 + hw_random16(cols - x0 - 2), y1 = y0 + 2 + hw_random16(rows - y0 - 2);
+      for (unsigned x = x0; x <= x1; x++) { caSetCell(wire, cols, x, y0, true); caSetCell(wire, cols, x, y1, true); }
+      for (unsigned y = y0; y <= y1; y++) { caSetCell(wire, cols, x0, y, true); caSetCell(wire, cols, x1, y, true); }
+      // electron travelling clockwise along top edge
+      caSetCell(wire, cols, x0 + 1, y0, false); caSetCell(head, cols, x0 + 1, y0, true);
+      caSetCell(wire, cols, x0,     y0, false); caSetCell(tail, cols, x0,     y0, true);
+    }
+    memset(hashes, 0, CA_HASH_HISTORY * sizeof(uint32_t));
+  } else if (strip.now - SEGENV.step < FRAMETIME_FIXED * (uint32_t)map(SEGMENT.speed,0,255,64,1)) {
+    return FRAMETIME;
+  } else {
+    uint32_t active = 0;
+    for (unsigned y = 0; y < rows; y++) for (unsigned i = 0; i < words; i++) {
+      uint32_t c[4];
+      caCountNeighbours(head, cols, rows, y, i, c);
+      const unsigned k = y * words + i;
+      nextHead[k] = wire[k] & caCountIn(c, 1<<1 | 1<<2);
+      nextTail[k] = head[k];
+      nextWire[k] = tail[k] | (wire[k] & ~nextHead[k]);
+      active |= nextHead[k];
+    }
+    SEGENV.aux1 ^= 1;
+    std::swap(head, nextHead);
+    std::swap(tail, nextTail);
+    std::swap(wire, nextWire);
+    // circuits with electrons are periodic by design so only reset if no electrons are left
+    if (active) SEGENV.step = strip.now;
+  }
+
+  const uint32_t bgc = SEGCOLOR(1);
+  for (unsigned y = 0; y < rows; y++) for (unsigned x = 0; x < cols; x++) {
+    uint32_t color = bgc;
+    if      (caGetCell(head, cols, x, y)) color = SEGCOLOR(0);
+    else if (caGetCell(tail, cols, x, y)) color = color_fade(SEGCOLOR(0), 96);
+    else if (caGetCell(wire, cols, x, y)) color = SEGMENT.color_from_palette((x + y) * 255 / (cols + rows), false, PALETTE_SOLID_WRAP, 2, 48);
+    SEGMENT.setPixelColorXY(x, y, color);
+  }
+
+  return FRAMETIME;
+} // mode_2Dwireworld()
+static const char _data_FX_MODE_2DWIREWORLD[] PROGMEM = "Wireworld@!,Loops;!,!;!;2;ix=96";
+
+
+/////////////////////////
+//   2D Langton's Ant  //
+/////////////////////////
+// ants turn right on empty cell and left on set cell, flip the cell and move forward
+typedef struct LangtonAnt {
+  uint16_t x, y;
+  uint8_t  dir; // 0 - up, 1 - right, 2 - down, 3 - left
+} langtonAnt;
+
+uint16_t mode_2Dlangton(void) {
+  if (!strip.isMatrix || !SEGMENT.is2D()) return mode_static(); // not a 2D set-up
+
+  const unsigned cols  = SEG_W;
+  const unsigned rows  = SEG_H;
+  const unsigned ants  = 1 + SEGMENT.intensity / 64;
+  uint32_t *cells = allocateGrids(1, cols, rows, 4 * sizeof(langtonAnt));
+  if (!cells) return mode_static(); //allocation failed
+  langtonAnt *ant = reinterpret_cast<langtonAnt*>(cells + caWords(cols) * rows);
+
+  if (SEGENV.call == 0 || SEGENV.aux0 != ants) {
+    SEGENV.aux0 = ants;
+    memset(cells, 0, caWords(cols) * rows * sizeof(uint32_t));
+    for (unsigned a = 0; a < 4; a++) ant[a] = {uint16_t(hw_random16(cols)), uint16_t(hw_random16(rows)), uint8_t(hw_random8(4))};
+  }
+
+  for (unsigned a = 0; a < ants; a++) { ant[a].x %= cols; ant[a].y %= rows; } // in case segment dimensions changed
+  const unsigned steps = 1 + SEGMENT.speed / 4; // steps per frame
+  for (unsigned s = 0; s < steps; s++) for (unsigned a = 0; a < ants; a++) {
+    const bool set = caGetCell(cells, cols, ant[a].x, ant[a].y);
+    ant[a].dir = (ant[a].dir + (set ? 3 : 1)) & 3;
+    caSetCell(cells, cols, ant[a].x, ant[a].y, !set);
+    switch (ant[a].dir) {
+      case 0: ant[a].y = ant[a].y ? ant[a].y - 1 : rows - 1; break;
+      case 1: ant[a].x = ant[a].x + 1 < cols ? ant[a].x + 1 : 0; break;
+      case 2: ant[a].y = ant[a].y + 1 < rows ? ant[a].y + 1 : 0; break;
+      case 3: ant[a].x = ant[a].x ? ant[a].x - 1 : cols - 1; break;
+    }
+  }
+
+  const uint32_t bgc = SEGCOLOR(1);
+  for (unsigned y = 0; y < rows; y++) for (unsigned x = 0; x < cols; x++) {
+    SEGMENT.setPixelColorXY(x, y, caGetCell(cells, cols, x, y) ? SEGMENT.color_from_palette(y * 255 / rows, false, PALETTE_SOLID_WRAP, 0) : bgc);
+  }
+  for (unsigned a = 0; a < ants; a++) SEGMENT.setPixelColorXY(ant[a].x, ant[a].y, SEGCOLOR(0));
+
+  return FRAMETIME;
+} // mode_2Dlangton()
+static const char _data_FX_MODE_2DLANGTON[] PROGMEM = "Langton's Ant@!,Ants;!,!;!;2;ix=0";
+
+
 /////////////////////////
 //     2D Hiphotic     //
 /////////////////////////
@@ -7601,45 +7783,22 @@ uint16_t mode_2Doctopus() {
 
   const int cols = SEG_W;
   const int rows = SEG_H;
-  const auto XY = [&](int x, int y) { return (x%cols) + (y%rows) * cols; };
   const uint8_t mapp = 180 / MAX(cols,rows);
+  const int C_X = (cols / 2) + ((SEGMENT.custom1 - 128)*cols)/255;
+  const int C_Y = (rows / 2) + ((SEGMENT.custom2 - 128)*rows)/255;
 
-  typedef struct {
-    uint8_t angle;
-    uint8_t radius;
-  } map_t;
-
-  const size_t dataSize = SEGMENT.width() * SEGMENT.height() * sizeof(map_t); // prevent reallocation if mirrored or grouped
-  if (!SEGENV.allocateData(dataSize + 2)) return mode_static(); //allocation failed
+  // angle/radius map is shared with other segments of the same size and centre
+  const geometry2D_t *geo = getGeometry2D(cols, rows, C_X, C_Y);
+  if (!geo) return mode_static(); //allocation failed
 
-  map_t *rMap = reinterpret_cast<map_t*>(SEGENV.data);
-  uint8_t *offsX = reinterpret_cast<uint8_t*>(SEGENV.data + dataSize);
-  uint8_t *offsY = reinterpret_cast<uint8_t*>(SEGENV.data + dataSize + 1);
-
-  // re-init if SEGMENT dimensions or offset changed
-  if (SEGENV.call == 0 || SEGENV.aux0 != cols || SEGENV.aux1 != rows || SEGMENT.custom1 != *offsX || SEGMENT.custom2 != *offsY) {
-    SEGENV.step = 0; // t
-    SEGENV.aux0 = cols;
-    SEGENV.aux1 = rows;
-    *offsX = SEGMENT.custom1;
-    *offsY = SEGMENT.custom2;
-    const int C_X = (cols / 2) + ((SEGMENT.custom1 - 128)*cols)/255;
-    const int C_Y = (rows / 2) + ((SEGMENT.custom2 - 128)*rows)/255;
-    for (int x = 0; x < cols; x++) {
-      for (int y = 0; y < rows; y++) {
-        int dx = (x - C_X);
-        int dy = (y - C_Y);
-        rMap[XY(x, y)].angle  = int(40.7436f * atan2_t(dy, dx));  // avoid 128*atan2()/PI
-        rMap[XY(x, y)].radius = sqrtf(dx * dx + dy * dy) * mapp; //thanks Sutaburosu
-      }
-    }
-  }
+  if (SEGENV.call == 0) SEGENV.step = 0; // t
 
   SEGENV.step += SEGMENT.speed / 32 + 1;  // 1-4 range
-  for (int x = 0; x < cols; x++) {
-    for (int y = 0; y < rows; y++) {
-      byte angle = rMap[XY(x,y)].angle;
-      byte radius = rMap[XY(x,y)].radius;
+  for (int y = 0; y < rows; y++) {
+    for (int x = 0; x < cols; x++) {
+      const unsigned i = y * cols + x;
+      byte angle = geo->angle[i];
+      byte radius = (geo->radius[i] * mapp) >> 4; //thanks Sutaburosu
       //CRGB c = CHSV(SEGENV.step / 2 - radius, 255, sin8_t(sin8_t((angle * 4 - radius) / 4 + SEGENV.step) + radius - SEGENV.step * 2 + angle * (SEGMENT.custom3/3+1)));
       unsigned intensity = sin8_t(sin8_t((angle * 4 - radius) / 4 + SEGENV.step/2) + radius - SEGENV.step + angle * (SEGMENT.custom3/4+1));
       intensity = map((intensity*intensity) & 0xFFFF, 0, 65535, 0, 255); // add a bit of non-linearity for cleaner display
@@ -7723,6 +7882,7 @@ uint16_t mode_particlevortex(void) {
       PartSys->particles[partindex].y = (PartSys->maxY + 1) >> 1; // center
       PartSys->particles[partindex].sat = 230;
       PartSys->particles[partindex].ttl = 256; //keep alive
+      PartSys->particleFlags[partindex].perpetual = true; // fixed index: must not be moved by particle compaction
     }
   }
   #endif
@@ -8907,6 +9067,7 @@ uint16_t mode_particleghostrider(void) {
   PartSys->particles[PartSys->usedParticles-1].y = PartSys->sources[0].source.y;
   PartSys->particles[PartSys->usedParticles-1].ttl = 255;
   PartSys->particles[PartSys->usedParticles-1].sat = 0; //white
+  PartSys->particleFlags[PartSys->usedParticles-1].perpetual = true; // fixed index: must not be moved by particle compaction
   // emit two particles
   PartSys->angleEmit(PartSys->sources[0], emitangle, speed);
   PartSys->angleEmit(PartSys->sources[0], emitangle, speed);
@@ -10636,7 +10797,7 @@ void WS2812FX::setupEffectData() {
   addEffect(FX_MODE_TWO_DOTS, &mode_two_dots, _data_FX_MODE_TWO_DOTS);
   addEffect(FX_MODE_FAIRYTWINKLE, &mode_fairytwinkle, _data_FX_MODE_FAIRYTWINKLE);
   addEffect(FX_MODE_RUNNING_DUAL, &mode_running_dual, _data_FX_MODE_RUNNING_DUAL);
-  #ifdef WLED_ENABLE_GIF
+  #if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
   addEffect(FX_MODE_IMAGE, &mode_image, _data_FX_MODE_IMAGE);
   #endif
   addEffect(FX_MODE_TRICOLOR_CHASE, &mode_tricolor_chase, _data_FX_MODE_TRICOLOR_CHASE);
@@ -10766,6 +10927,9 @@ void WS2812FX::setupEffectData() {
   addEffect(FX_MODE_2DCOLOREDBURSTS, &mode_2DColoredBursts, _data_FX_MODE_2DCOLOREDBURSTS);
   addEffect(FX_MODE_2DJULIA, &mode_2DJulia, _data_FX_MODE_2DJULIA);
   addEffect(FX_MODE_2DGAMEOFLIFE, &mode_2Dgameoflife, _data_FX_MODE_2DGAMEOFLIFE);
+  addEffect(FX_MODE_2DBRIANSBRAIN, &mode_2Dbriansbrain, _data_FX_MODE_2DBRIANSBRAIN);
+  addEffect(FX_MODE_2DWIREWORLD, &mode_2Dwireworld, _data_FX_MODE_2DWIREWORLD);
+  addEffect(FX_MODE_2DLANGTON, &mode_2Dlangton, _data_FX_MODE_2DLANGTON);
   addEffect(FX_MODE_2DTARTAN, &mode_2Dtartan, _data_FX_MODE_2DTARTAN);
   addEffect(FX_MODE_2DPOLARLIGHTS, &mode_2DPolarLights, _data_FX_MODE_2DPOLARLIGHTS);
   addEffect(FX_MODE_2DSWIRL, &mode_2DSwirl, _data_FX_MODE_2DSWIRL); // audio
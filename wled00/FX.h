@@ -107,6 +107,12 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / WS2812FX::getMaxSegments())
 
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
+#define SHOW_CHUNK_SIZE  64 // pixels handed to BusManager::setPixels() at once in show() (stack buffer)
+
+// expand current palette into a 256 entry lookup table used by color_from_palette() (uses 1kB of RAM)
+#if !defined(ESP8266) && !defined(WLED_SAVE_RAM)
+  #define WLED_PALETTE_LUT
+#endif
 
 #define NUM_COLORS       3 /* number of colors per segment */
 #define SEGMENT          (*strip._currentSegment)
@@ -373,7 +379,10 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define FX_MODE_PS1DSONICBOOM          215
 #define FX_MODE_PS1DSPRINGY            216
 #define FX_MODE_PARTICLEGALAXY         217
-#define MODE_COUNT                     218
+#define FX_MODE_2DBRIANSBRAIN          218
+#define FX_MODE_2DWIREWORLD            219
+#define FX_MODE_2DLANGTON              220
+#define MODE_COUNT                     221
 
 
 #define BLEND_STYLE_FADE            0x00  // universal
@@ -413,6 +422,40 @@ typedef enum mapping1D2D {
   M12_sPinwheel = 4
 } mapping1D2D_t;
 
+#ifndef WLED_DISABLE_2D
+// bit packed cellular automaton engine (FX_2Dfcn.cpp)
+// grid holds one bit per cell (cell x of a row is bit x&31 of word x>>5), each row is padded to caWords(cols) words
+// padding bits must be 0; neighbourhoods wrap around grid edges
+// neighbour counts are bit sliced: count = c[0] + 2*c[1] + 4*c[2] + 8*c[3] for 32 cells at once
+inline unsigned caWords(unsigned cols) { return (cols + 31) >> 5; }
+inline bool caGetCell(const uint32_t *grid, unsigned cols, unsigned x, unsigned y) { return (grid[y * caWords(cols) + (x >> 5)] >> (x & 31)) & 1; }
+inline void caSetCell(uint32_t *grid, unsigned cols, unsigned x, unsigned y, bool on) {
+  uint32_t &w = grid[y * caWords(cols) + (x >> 5)];
+  w = on ? w | (1U << (x & 31)) : w & ~(1U << (x & 31));
+}
+uint32_t caValidMask(unsigned cols, unsigned word);                                                         // cells of a row word that are inside grid
+void     caCountNeighbours(const uint32_t *grid, unsigned cols, unsigned rows, unsigned y, unsigned word, uint32_t c[4]); // Moore neighbourhood
+uint32_t caCountIn(const uint32_t c[4], uint16_t counts);                                                   // cells whose count is in counts (bit n = n neighbours)
+uint32_t caHash(const uint32_t *grid, size_t words);                                                        // for cycle detection
+
+// shared geometry cache (FX_2Dfcn.cpp)
+// polar coordinates of every pixel relative to a centre, built on first use and shared by all segments with the same
+// dimensions and centre; memory is accounted in Segment::_usedSegmentData
+// if all entries are in use by running effects a private copy is kept in effect data (SEGENV.data) of the calling
+// segment, so an effect using getGeometry2D() must not use SEGENV.data itself
+// returned pointer is only valid during current effect call (entry may be evicted by next getGeometry2D()), do not store it
+typedef struct Geometry2D {
+  uint16_t      width, height;  // key
+  int16_t       cx, cy;         // key: centre in pixels (may be outside of segment)
+  unsigned long lastUsed;       // millis()
+  uint16_t     *radius;         // [width*height] distance to centre in 1/16 pixel
+  int16_t      *nx, *ny;        // [width], [height] distance to centre in 1/256 of max(width,height)
+  uint8_t      *angle;          // [width*height] 0-255 = full turn, 0 = +x, 64 = +y
+} geometry2D_t;
+const geometry2D_t *getGeometry2D(unsigned width, unsigned height, int cx, int cy);
+void purgeGeometry2D(bool all = false); // release entries unused for a while (or all)
+#endif
+
 class WS2812FX;
 
 // segment, 76 bytes
@@ -482,6 +525,7 @@ class Segment {
         bool    _manualW  : 1;
       };
     };
+    uint16_t _cost;                   // smoothed effect execution time in us (used by frame budget scheduler in WS2812FX::service())
 
     // static variables are use to speed up effect calculations by stashing common pre-calculated values
     static unsigned      _usedSegmentData;    // amount of data used by all segments
@@ -491,9 +535,15 @@ class Segment {
     static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
+  #ifdef WLED_PALETTE_LUT
+    static uint32_t      _paletteLUT[256];    // _currentPalette expanded to 256 colors (lazily built in color_from_palette())
+    static CRGBPalette16 _paletteLUTSource;   // palette _paletteLUT was built from
+    static uint8_t       _paletteLUTType;     // 0 - invalid, 1 - LINEARBLEND, 2 - NOBLEND
+  #endif
     static uint16_t      _lastPaletteChange;  // last random palette change time (in seconds)
     static uint16_t      _nextPaletteBlend;   // next due time for random palette morph (in millis())
     static bool          _modeBlend;          // mode/effect blending semaphore
+    static bool          _reducedQuality;     // frame budget exceeded, effect should render cheaper variant (set by WS2812FX::service())
     // clipping rectangle used for blending
     static uint16_t      _clipStart, _clipStop;
     static uint8_t       _clipStartY, _clipStopY;
@@ -560,6 +610,9 @@ class Segment {
     inline static bool isPreviousMode()       { return Segment::_modeBlend; }    // needed for determining CCT/opacity during non-BLEND_STYLE_FADE transition
 
     static void handleRandomPalette();
+  #ifdef WLED_PALETTE_LUT
+    static void buildPaletteLUT(uint8_t type);
+  #endif
 
   public:
 
@@ -596,6 +649,7 @@ class Segment {
     , _dataLen(0)
     , _default_palette(6)
     , _capabilities(0)
+    , _cost(0)
     , _t(nullptr)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
@@ -653,6 +707,7 @@ class Segment {
     inline static unsigned vHeight()                       { return Segment::_vHeight; }
     inline static uint32_t getCurrentColor(unsigned i)     { return Segment::_currentColors[i<NUM_COLORS?i:0]; }
     inline static const CRGBPalette16 &getCurrentPalette() { return Segment::_currentPalette; }
+    inline static bool     isReducedQuality()              { return Segment::_reducedQuality; } // effects may skip expensive passes (blur, oversampling, ...) if true
 
     inline void setDrawDimensions() const { Segment::_vWidth = virtualWidth(); Segment::_vHeight = virtualHeight(); Segment::_vLength = virtualLength(); }
 
@@ -669,6 +724,7 @@ class Segment {
 
     // runtime data functions
     inline uint16_t dataSize() const { return _dataLen; }
+    inline uint16_t cost() const     { return _cost; }  // smoothed effect execution time (us)
     bool allocateData(size_t len);  // allocates effect data buffer in heap and clears it
     void deallocateData();          // deallocates (frees) effect data buffer from heap
     /**
@@ -747,7 +803,7 @@ class Segment {
     inline void fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade) const                   { setPixelColorXY(x, y, color_fade(getPixelColorXY(x,y), fade, true)); }
     inline void blurCols(fract8 blur_amount, bool smear = false) const                         { blur2D(0, blur_amount, smear); } // blur all columns (50% faster than full 2D blur)
     inline void blurRows(fract8 blur_amount, bool smear = false) const                         { blur2D(blur_amount, 0, smear); } // blur all rows (50% faster than full 2D blur)
-    //void box_blur(unsigned r = 1U, bool smear = false); // 2D box blur
+    void box_blur(unsigned radius = 1U) const; // 2D box blur (true radius, up to 127)
     void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) const;
     void moveX(int delta, bool wrap = false) const;
     void moveY(int delta, bool wrap = false) const;
@@ -782,7 +838,7 @@ class Segment {
     inline void addPixelColorXY(int x, int y, byte r, byte g, byte b, byte w = 0, bool saturate = false) const { addPixelColor(x, RGBW32(r,g,b,w), saturate); }
     inline void addPixelColorXY(int x, int y, CRGB c, bool saturate = false) const         { addPixelColor(x, RGBW32(c.r,c.g,c.b,0), saturate); }
     inline void fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade) const               { fadePixelColor(x, fade); }
-    //inline void box_blur(unsigned i, bool vertical, fract8 blur_amount) {}
+    inline void box_blur(unsigned radius = 1U) const {}
     inline void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) {}
     inline void blurCols(fract8 blur_amount, bool smear = false) { blur(blur_amount, smear); } // blur all columns (50% faster than full 2D blur)
     inline void blurRows(fract8 blur_amount, bool smear = false) {}
@@ -802,6 +858,72 @@ class Segment {
   friend class WS2812FX;
 };
 
+// binary ledmap (ledmapN.bin) header, followed by nameLen bytes of name and count uint16_t (LE) indices (0xFFFF = no LED)
+#define LEDMAP_BIN_MAGIC   0x50414D4CU // "LMAP"
+#define LEDMAP_BIN_VERSION 1
+typedef struct __attribute__((packed)) {
+  uint32_t magic;
+  uint8_t  version;
+  uint8_t  nameLen;
+  uint16_t width;   // 0 if not a matrix
+  uint16_t height;  // 0 if not a matrix
+  uint16_t count;   // number of entries in map
+  uint8_t  reserved[4];
+} ledmap_bin_t;
+
+// ledmap compiled into runs: logical pixels [start, start+len) map to physical pixels target + k*stride
+// (target 0xFFFF with stride 0 denotes a run of missing pixels)
+typedef struct {
+  uint16_t start;
+  uint16_t target;
+  uint16_t len;
+  int16_t  stride;
+} ledmap_run_t;
+
+#ifdef WLED_ENABLE_PERF
+// effect profiler (served on /json/perf), all times in microseconds
+// statistics are collected in windows of WLED_PERF_WINDOW ms, last complete window is reported
+#ifndef WLED_PERF_WINDOW
+  #define WLED_PERF_WINDOW 5000
+#endif
+#define WLED_PERF_MODES 16 // number of distinct effects tracked (least recently used is replaced)
+typedef struct PerfStat {
+  uint32_t sum, min, max;     // current window
+  uint16_t cnt;
+  uint16_t lCnt;              // last window: number of samples
+  uint32_t lAvg, lMin, lMax;  // last window
+  inline void add(uint32_t t) { if (!cnt || t < min) min = t; if (t > max) max = t; sum += t; if (cnt < 0xFFFF) cnt++; }
+  inline void roll()          { lCnt = cnt; lAvg = cnt ? sum / cnt : 0; lMin = min; lMax = max; sum = min = max = cnt = 0; }
+  inline void reset()         { sum = min = max = cnt = lCnt = lAvg = lMin = lMax = 0; }
+} perf_stat_t;
+typedef struct PerfSegment {
+  perf_stat_t fx;             // current effect function
+  perf_stat_t fxOld;          // old effect function (during transition)
+  perf_stat_t blend;          // blendSegment()
+  uint32_t    dataLen;        // largest allocateData() request
+  uint16_t    dataFail;       // failed allocateData() requests
+  uint8_t     mode;           // effect the statistics belong to (reset on change)
+} perf_segment_t;
+typedef struct PerfMode {
+  perf_stat_t   fx;
+  unsigned long lastUsed;     // millis()
+  uint8_t       id;           // effect id (0 with lastUsed == 0 denotes empty slot)
+} perf_mode_t;
+typedef struct PerfData {
+  perf_stat_t    service;     // whole WS2812FX::service() (effects + show)
+  perf_stat_t    show;        // whole WS2812FX::show()
+  perf_stat_t    bus;         // BusManager::show()
+  perf_segment_t seg[MAX_NUM_SEGMENTS];
+  perf_mode_t    mode[WLED_PERF_MODES];
+  uint32_t       dataPeak;    // peak of Segment::getUsedSegmentData()
+  unsigned long  windowStart; // millis()
+} perf_data_t;
+extern perf_data_t perfData;
+void perfAddMode(uint8_t id, uint32_t t); // add effect execution time to per-effect statistics
+void perfAllocData(size_t len, bool ok);  // called from Segment::allocateData()
+void perfRoll();                          // closes statistics window if elapsed
+#endif
+
 // main "strip" class (104 bytes)
 class WS2812FX {
   typedef uint16_t (*mode_ptr)(); // pointer to mode function
@@ -842,10 +964,14 @@ class WS2812FX {
       _triggered(false),
       _segment_index(0),
       _mainSegment(0),
+      _throttle(0),
+      _lightFrames(0),
       _modeCount(MODE_COUNT),
       _callback(nullptr),
       customMappingTable(nullptr),
+      customMappingRuns(nullptr),
       customMappingSize(0),
+      customMappingRunCount(0),
       _lastShow(0),
       _lastServiceShow(0)
     {
@@ -858,6 +984,7 @@ class WS2812FX {
     ~WS2812FX() {
       d_free(_pixels);
       d_free(customMappingTable);
+      d_free(customMappingRuns);
       _mode.clear();
       _modeData.clear();
       _segments.clear();
@@ -936,16 +1063,18 @@ class WS2812FX {
 
     inline uint16_t getFps() const          { return (millis() - _lastShow > 2000) ? 0 : (FPS_MULTIPLIER * _cumulativeFps) >> FPS_CALC_SHIFT; } // Returns the refresh rate of the LED strip (_cumulativeFps is stored in fixed point)
     inline uint16_t getFrameTime() const    { return _frametime; }        // returns amount of time a frame should take (in ms)
+    inline uint8_t getThrottle() const      { return _throttle; }         // returns frame budget scheduler level (0 = all segments run at full rate)
     inline uint16_t getMinShowDelay() const { return MIN_FRAME_DELAY; }   // returns minimum amount of time strip.service() can be delayed (constant)
     inline uint16_t getLength() const       { return _length; }           // returns actual amount of LEDs on a strip (2D matrix may have less LEDs than W*H)
     inline uint16_t getTransition() const   { return _transitionDur; }    // returns currently set transition time (in ms)
     inline uint16_t getMappedPixelIndex(uint16_t index) const {           // convert logical address to physical
-      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) index = customMappingTable[index];
+      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) index = customMappingRuns ? getMappedRunIndex(index) : customMappingTable[index];
       return index;
     };
 
     unsigned long now, timebase;
     inline uint32_t getPixelColor(unsigned n) const { return (n < getLengthTotal()) ? _pixels[n] : 0; } // returns color of pixel n
+    inline const uint32_t *getPixels() const        { return _pixels; }                   // returns frame buffer (getLengthTotal() pixels)
     inline uint32_t getLastShow() const             { return _lastShow; }                 // returns millis() timestamp of last strip.show() call
 
     const char *getModeData(unsigned id = 0) const  { return (id && id < _modeCount) ? _modeData[id] : PSTR("Solid"); }
@@ -1026,6 +1155,8 @@ class WS2812FX {
 
     uint8_t _segment_index;
     uint8_t _mainSegment;
+    uint8_t _throttle;     // frame budget scheduler level (0 - off, up to WLED_THROTTLE_MAX)
+    uint8_t _lightFrames;  // consecutive frames well within budget (for lowering _throttle)
 
     uint8_t                  _modeCount;
     std::vector<mode_ptr>    _mode;     // SRAM footprint: 4 bytes per element
@@ -1033,12 +1164,19 @@ class WS2812FX {
 
     show_callback _callback;
 
-    uint16_t* customMappingTable;
-    uint16_t  customMappingSize;
+    uint16_t*     customMappingTable;    // per-pixel ledmap (only kept if ledmap does not compile into fewer runs)
+    ledmap_run_t* customMappingRuns;     // compiled ledmap (replaces customMappingTable)
+    uint16_t      customMappingSize;
+    uint16_t      customMappingRunCount;
 
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
 
+    bool deserializeBinaryMap(const char *fileName, unsigned n); // loads ledmapN.bin, called from deserializeMap()
+    void releaseMap();                                           // frees ledmap table and runs
+    void compileMap();                                           // compiles customMappingTable into runs (if it saves memory)
+    uint16_t getMappedRunIndex(uint16_t index) const;            // lookup into compiled ledmap (index < customMappingSize)
+
     friend class Segment;
 };
 
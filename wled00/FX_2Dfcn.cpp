@@ -51,7 +51,7 @@ void WS2812FX::setUpMatrix() {
 
     customMappingSize = 0; // prevent use of mapping if anything goes wrong
 
-    d_free(customMappingTable);
+    releaseMap();
     customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer to not use SPI RAM
 
     if (customMappingTable) {
@@ -114,7 +114,6 @@ void WS2812FX::setUpMatrix() {
 
       // delete gap array as we no longer need it
       p_free(gapTable);
-      resume();
 
       #ifdef WLED_DEBUG
       DEBUG_PRINT(F("Matrix ledmap:"));
@@ -124,6 +123,9 @@ void WS2812FX::setUpMatrix() {
       }
       DEBUG_PRINTLN();
       #endif
+
+      compileMap(); // panels (serpentine or not) are long runs of +1/-1 strides
+      resume();
     } else { // memory allocation error
       DEBUG_PRINTLN(F("ERROR 2D LED map allocation error."));
       isMatrix = false;
@@ -245,131 +247,28 @@ void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) const {
   if (!isActive()) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  const auto XY = [&](unsigned x, unsigned y){ return x + y*cols; };
-  uint32_t lastnew; // not necessary to initialize lastnew and last, as both will be initialized by the first loop iteration
-  uint32_t last;
   if (blur_x) {
     const uint8_t keepx = smear ? 255 : 255 - blur_x;
     const uint8_t seepx = blur_x >> 1;
-    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
-      uint32_t carryover = BLACK;
-      uint32_t curnew = BLACK;
-      for (unsigned x = 0; x < cols; x++) {
-        uint32_t cur = getPixelColorRaw(XY(x, row));
-        uint32_t part = color_fade(cur, seepx);
-        curnew = color_fade(cur, keepx);
-        if (x > 0) {
-          if (carryover) curnew = color_add(curnew, carryover);
-          uint32_t prev = color_add(lastnew, part);
-          // optimization: only set pixel if color has changed
-          if (last != prev) setPixelColorRaw(XY(x - 1, row), prev);
-        } else setPixelColorRaw(XY(x, row), curnew); // first pixel
-        lastnew = curnew;
-        last = cur; // save original value for comparison on next iteration
-        carryover = part;
-      }
-      setPixelColorRaw(XY(cols-1, row), curnew); // set last pixel
-    }
+    for (unsigned row = 0; row < rows; row++) blurLine(pixels + row * cols, cols, 1, keepx, seepx); // blur rows (x direction)
   }
   if (blur_y) {
     const uint8_t keepy = smear ? 255 : 255 - blur_y;
     const uint8_t seepy = blur_y >> 1;
-    for (unsigned col = 0; col < cols; col++) {
-      uint32_t carryover = BLACK;
-      uint32_t curnew = BLACK;
-      for (unsigned y = 0; y < rows; y++) {
-        uint32_t cur = getPixelColorRaw(XY(col, y));
-        uint32_t part = color_fade(cur, seepy);
-        curnew = color_fade(cur, keepy);
-        if (y > 0) {
-          if (carryover) curnew = color_add(curnew, carryover);
-          uint32_t prev = color_add(lastnew, part);
-          // optimization: only set pixel if color has changed
-          if (last != prev) setPixelColorRaw(XY(col, y - 1), prev);
-        } else setPixelColorRaw(XY(col, y), curnew); // first pixel
-        lastnew = curnew;
-        last = cur; //save original value for comparison on next iteration
-        carryover = part;
-      }
-      setPixelColorRaw(XY(col, rows - 1), curnew);
-    }
+    for (unsigned col = 0; col < cols; col++) blurLine(pixels + col, rows, cols, keepy, seepy); // blur columns (y direction)
   }
 }
 
-/*
-// 2D Box blur
-void Segment::box_blur(unsigned radius, bool smear) {
+// 2D box blur with (2*radius+1)^2 pixel window, separable (rows, then columns) using running sums
+void Segment::box_blur(unsigned radius) const {
   if (!isActive() || radius == 0) return; // not active
-  if (radius > 3) radius = 3;
-  const unsigned d = (1 + 2*radius) * (1 + 2*radius); // averaging divisor
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  uint16_t *tmpRSum = new uint16_t[cols*rows];
-  uint16_t *tmpGSum = new uint16_t[cols*rows];
-  uint16_t *tmpBSum = new uint16_t[cols*rows];
-  uint16_t *tmpWSum = new uint16_t[cols*rows];
-  // fill summed-area table (https://en.wikipedia.org/wiki/Summed-area_table)
-  for (unsigned x = 0; x < cols; x++) {
-    unsigned rS, gS, bS, wS;
-    unsigned index;
-    rS = gS = bS = wS = 0;
-    for (unsigned y = 0; y < rows; y++) {
-      index = x * cols + y;
-      if (x > 0) {
-        unsigned index2 = (x - 1) * cols + y;
-        tmpRSum[index] = tmpRSum[index2];
-        tmpGSum[index] = tmpGSum[index2];
-        tmpBSum[index] = tmpBSum[index2];
-        tmpWSum[index] = tmpWSum[index2];
-      } else {
-        tmpRSum[index] = 0;
-        tmpGSum[index] = 0;
-        tmpBSum[index] = 0;
-        tmpWSum[index] = 0;
-      }
-      uint32_t c = getPixelColorXY(x, y);
-      rS += R(c);
-      gS += G(c);
-      bS += B(c);
-      wS += W(c);
-      tmpRSum[index] += rS;
-      tmpGSum[index] += gS;
-      tmpBSum[index] += bS;
-      tmpWSum[index] += wS;
-    }
-  }
-  // do a box blur using pre-calculated sums
-  for (unsigned x = 0; x < cols; x++) {
-    for (unsigned y = 0; y < rows; y++) {
-      // sum = D + A - B - C where k = (x,y)
-      // +----+-+---- (x)
-      // |    | |
-      // +----A-B
-      // |    |k|
-      // +----C-D
-      // |
-      //(y)
-      unsigned x0 = x < radius ? 0 : x - radius;
-      unsigned y0 = y < radius ? 0 : y - radius;
-      unsigned x1 = x >= cols - radius ? cols - 1 : x + radius;
-      unsigned y1 = y >= rows - radius ? rows - 1 : y + radius;
-      unsigned A = x0 * cols + y0;
-      unsigned B = x1 * cols + y0;
-      unsigned C = x0 * cols + y1;
-      unsigned D = x1 * cols + y1;
-      unsigned r = tmpRSum[D] + tmpRSum[A] - tmpRSum[C] - tmpRSum[B];
-      unsigned g = tmpGSum[D] + tmpGSum[A] - tmpGSum[C] - tmpGSum[B];
-      unsigned b = tmpBSum[D] + tmpBSum[A] - tmpBSum[C] - tmpBSum[B];
-      unsigned w = tmpWSum[D] + tmpWSum[A] - tmpWSum[C] - tmpWSum[B];
-      setPixelColorXY(x, y, RGBW32(r/d, g/d, b/d, w/d));
-    }
-  }
-  delete[] tmpRSum;
-  delete[] tmpGSum;
-  delete[] tmpBSum;
-  delete[] tmpWSum;
+  uint32_t tmp[max(cols, rows)]; // line buffer
+  for (unsigned row = 0; row < rows; row++) boxBlurLine(pixels + row * cols, cols, 1, radius, tmp);
+  for (unsigned col = 0; col < cols; col++) boxBlurLine(pixels + col, rows, cols, radius, tmp);
 }
-*/
+
 void Segment::moveX(int delta, bool wrap) const {
   if (!isActive() || !delta) return; // not active
   const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
@@ -637,4 +536,164 @@ void Segment::wu_pixel(uint32_t x, uint32_t y, CRGB c) const {      //awesome wu
 }
 #undef WU_WEIGHT
 
+/////////////////////////////////////////////
+// bit packed cellular automaton engine
+// used by Game Of Life, Brian's Brain, Wireworld and Langton's Ant
+// all functions work on 32 cells at once and contain no per-cell branches
+/////////////////////////////////////////////
+
+uint32_t caValidMask(unsigned cols, unsigned word) {
+  const unsigned bits = cols - (word << 5);
+  return bits >= 32 ? 0xFFFFFFFFU : (1U << bits) - 1;
+}
+
+// neighbour to the west (x-1) or east (x+1) of each cell in a row word, wrapping around (may set padding bits)
+static inline uint32_t caWest(const uint32_t *row, unsigned word, unsigned cols) {
+  const unsigned last = cols - 1;
+  return (row[word] << 1) | (word ? row[word-1] >> 31 : (row[last >> 5] >> (last & 31)) & 1);
+}
+
+static inline uint32_t caEast(const uint32_t *row, unsigned word, unsigned cols) {
+  const unsigned last = cols - 1;
+  return (row[word] >> 1) | (word < (last >> 5) ? row[word+1] << 31 : (row[0] & 1) << (last & 31));
+}
+
+void caCountNeighbours(const uint32_t *grid, unsigned cols, unsigned rows, unsigned y, unsigned word, uint32_t c[4]) {
+  const unsigned words = caWords(cols);
+  const uint32_t *up   = grid + ((y + rows - 1) % rows) * words;
+  const uint32_t *row  = grid + y * words;
+  const uint32_t *down = grid + ((y + 1) % rows) * words;
+  const uint32_t n[8] = { caWest(up, word, cols),   up[word],   caEast(up, word, cols),
+                          caWest(row, word, cols),              caEast(row, word, cols),
+                          caWest(down, word, cols), down[word], caEast(down, word, cols) };
+  // bit sliced adder
+  uint32_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+  for (unsigned i = 0; i < 8; i++) {
+    const uint32_t carry0 = c0 & n[i]; c0 ^= n[i];
+    const uint32_t carry1 = c1 & carry0; c1 ^= carry0;
+    const uint32_t carry2 = c2 & carry1; c2 ^= carry1;
+    c3 |= carry2;
+  }
+  c[0] = c0; c[1] = c1; c[2] = c2; c[3] = c3;
+}
+
+uint32_t caCountIn(const uint32_t c[4], uint16_t counts) {
+  uint32_t cells = 0;
+  for (unsigned n = 0; n <= 8; n++) if (counts & (1U << n)) {
+    cells |= (n & 1 ? c[0] : ~c[0]) & (n & 2 ? c[1] : ~c[1]) & (n & 4 ? c[2] : ~c[2]) & (n & 8 ? c[3] : ~c[3]);
+  }
+  return cells;
+}
+
+// FNV-1a
+uint32_t caHash(const uint32_t *grid, size_t words) {
+  uint32_t hash = 2166136261U;
+  for (size_t i = 0; i < words; i++) hash = (hash ^ grid[i]) * 16777619U;
+  return hash;
+}
+
+/////////////////////////////////////////////
+// shared geometry cache
+// polar coordinates are expensive (atan2, sqrt) but only depend on segment
+// dimensions and centre so they are computed once and shared among segments
+/////////////////////////////////////////////
+
+#ifndef WLED_GEOMETRY_CACHE_SIZE
+  #ifdef ESP8266
+    #define WLED_GEOMETRY_CACHE_SIZE 2
+  #else
+    #define WLED_GEOMETRY_CACHE_SIZE 4
+  #endif
+#endif
+#define GEOMETRY_CACHE_TIMEOUT 2000 // release entries unused for 2s
+#define GEOMETRY_CACHE_BUSY     250 // entries used within 250ms belong to a running effect and are not evicted
+
+static geometry2D_t geometryCache[WLED_GEOMETRY_CACHE_SIZE];
+
+static inline size_t geometrySize(unsigned width, unsigned height) {
+  return width * height * (sizeof(uint16_t) + sizeof(uint8_t)) + (width + height) * sizeof(int16_t);
+}
+
+static void releaseGeometry(geometry2D_t &g) {
+  if (!g.radius) return;
+  d_free(g.radius);
+  Segment::addUsedSegmentData(-(int)geometrySize(g.width, g.height));
+  g.radius = nullptr;
+  g.width = g.height = 0;
+}
+
+// buf must hold geometrySize(width, height) bytes
+static void buildGeometry(geometry2D_t &g, uint8_t *buf, unsigned width, unsigned height, int cx, int cy) {
+  const int scale = (256 << 4) / max(width, height); // 1/16 pixel to 1/256 of longest side
+  g.width    = width;
+  g.height   = height;
+  g.cx       = cx;
+  g.cy       = cy;
+  g.lastUsed = millis();
+  g.radius   = reinterpret_cast<uint16_t*>(buf);
+  g.nx       = reinterpret_cast<int16_t*>(g.radius + width * height);
+  g.ny       = g.nx + width;
+  g.angle    = reinterpret_cast<uint8_t*>(g.ny + height);
+  for (int x = 0; x < (int)width;  x++) g.nx[x] = ((x - cx) * scale) >> 4;
+  for (int y = 0; y < (int)height; y++) g.ny[y] = ((y - cy) * scale) >> 4;
+  for (int y = 0; y < (int)height; y++) {
+    const int dy = y - cy;
+    for (int x = 0; x < (int)width; x++) {
+      const int dx = x - cx;
+      const unsigned i = y * width + x;
+      g.radius[i] = sqrt32_bw((dx * dx + dy * dy) << 8); // 1/16 pixel
+      g.angle[i]  = int(40.7436f * atan2_t(dy, dx));     // avoid 128*atan2()/PI
+    }
+  }
+}
+
+// private copy in effect data of current segment, only rebuilt when its key changes
+static const geometry2D_t *segmentGeometry2D(unsigned width, unsigned height, int cx, int cy) {
+  if (!SEGENV.allocateData(sizeof(geometry2D_t) + geometrySize(width, height))) return nullptr;
+  geometry2D_t *g = reinterpret_cast<geometry2D_t*>(SEGENV.data);
+  uint8_t *buf = SEGENV.data + sizeof(geometry2D_t);
+  if (g->radius == reinterpret_cast<uint16_t*>(buf) && g->width == width && g->height == height && g->cx == cx && g->cy == cy) return g;
+  buildGeometry(*g, buf, width, height, cx, cy); // data is cleared (or moved) on (re)allocation
+  return g;
+}
+
+const geometry2D_t *getGeometry2D(unsigned width, unsigned height, int cx, int cy) {
+  if (width == 0 || height == 0) return nullptr;
+  const unsigned long now = millis();
+  geometry2D_t *slot = nullptr;
+  for (geometry2D_t &g : geometryCache) {
+    if (g.radius && g.width == width && g.height == height && g.cx == cx && g.cy == cy) {
+      g.lastUsed = now;
+      return &g;
+    }
+    if (!slot || (slot->radius && (!g.radius || g.lastUsed < slot->lastUsed))) slot = &g; // free or least recently used entry
+  }
+  // all entries are in use by running effects: evicting one would rebuild tables every frame
+  if (slot->radius && now - slot->lastUsed < GEOMETRY_CACHE_BUSY) return segmentGeometry2D(width, height, cx, cy);
+  releaseGeometry(*slot);
+
+  const size_t size = geometrySize(width, height);
+  if (Segment::getUsedSegmentData() + size > MAX_SEGMENT_DATA) {
+    DEBUG_PRINTF_P(PSTR("!!! Not enough RAM for geometry: %d/%d !!!\n"), size, Segment::getUsedSegmentData());
+    errorFlag = ERR_NORAM;
+    return nullptr;
+  }
+  // prefer DRAM over SPI RAM on ESP32 since it is slow
+  uint8_t *buf = (uint8_t*)d_malloc(size);
+  if (!buf) {
+    errorFlag = ERR_NORAM;
+    return nullptr;
+  }
+  Segment::addUsedSegmentData(size);
+  buildGeometry(*slot, buf, width, height, cx, cy);
+  return slot;
+}
+
+void purgeGeometry2D(bool all) {
+  const unsigned long now = millis();
+  for (geometry2D_t &g : geometryCache) {
+    if (g.radius && (all || now - g.lastUsed > GEOMETRY_CACHE_TIMEOUT)) releaseGeometry(g);
+  }
+}
+
 #endif // WLED_DISABLE_2D
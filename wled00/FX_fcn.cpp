@@ -49,8 +49,14 @@ CRGBPalette16 Segment::_randomPalette     = generateRandomPalette();  // was CRG
 CRGBPalette16 Segment::_newRandomPalette  = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 uint16_t      Segment::_lastPaletteChange = 0; // in seconds; perhaps it should be per segment
 uint16_t      Segment::_nextPaletteBlend  = 0; // in millis
+#ifdef WLED_PALETTE_LUT
+uint32_t      Segment::_paletteLUT[256];
+CRGBPalette16 Segment::_paletteLUTSource  = CRGBPalette16(CRGB::Black);
+uint8_t       Segment::_paletteLUTType    = 0;
+#endif
 
 bool     Segment::_modeBlend = false;
+bool     Segment::_reducedQuality = false;
 uint16_t Segment::_clipStart = 0;
 uint16_t Segment::_clipStop = 0;
 uint8_t  Segment::_clipStartY = 0;
@@ -148,6 +154,9 @@ bool Segment::allocateData(size_t len) {
     if (call == 0) {
       //DEBUG_PRINTF_P(PSTR("--   Clearing data (%d): %p\n"), len, this);
       memset(data, 0, len);  // erase buffer if called during effect initialisation
+      #ifdef WLED_ENABLE_PERF
+      perfAllocData(len, true);
+      #endif
     }
     return true;
   }
@@ -156,6 +165,9 @@ bool Segment::allocateData(size_t len) {
     // not enough memory
     DEBUG_PRINTF_P(PSTR("!!! Not enough RAM: %d/%d !!!\n"), len, Segment::getUsedSegmentData());
     errorFlag = ERR_NORAM;
+    #ifdef WLED_ENABLE_PERF
+    perfAllocData(len, false);
+    #endif
     return false;
   }
   // prefer DRAM over SPI RAM on ESP32 since it is slow
@@ -166,12 +178,18 @@ bool Segment::allocateData(size_t len) {
     Segment::addUsedSegmentData(len - _dataLen);
     _dataLen = len;
     //DEBUG_PRINTF_P(PSTR("---  Allocated data (%p): %d/%d -> %p\n"), this, len, Segment::getUsedSegmentData(), data);
+    #ifdef WLED_ENABLE_PERF
+    perfAllocData(len, true);
+    #endif
     return true;
   }
   // allocation failed
   DEBUG_PRINTLN(F("!!! Allocation failed. !!!"));
   Segment::addUsedSegmentData(-_dataLen); // subtract original buffer size
   errorFlag = ERR_NORAM;
+  #ifdef WLED_ENABLE_PERF
+  perfAllocData(len, false);
+  #endif
   return false;
 }
 
@@ -202,11 +220,29 @@ void Segment::resetIfRequired() {
   if (pixels) for (size_t i = 0; i < length(); i++) pixels[i] = BLACK; // clear pixel buffer
   next_time = 0; step = 0; call = 0; aux0 = 0; aux1 = 0;
   reset = false;
-  #ifdef WLED_ENABLE_GIF
+  #if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
   endImagePlayback(this);
   #endif
 }
 
+// number of decoded gradient palettes kept by loadPalette()
+#ifndef WLED_PALETTE_CACHE_SIZE
+  #ifdef ESP8266
+    #define WLED_PALETTE_CACHE_SIZE 2
+  #else
+    #define WLED_PALETTE_CACHE_SIZE 8
+  #endif
+#endif
+
+typedef struct {
+  CRGBPalette16 palette;
+  uint16_t      lastUsed;
+  uint8_t       id;       // palette ID (0 = empty slot, gradient palettes start at 13)
+} palette_cache_t;
+
+static palette_cache_t paletteCache[WLED_PALETTE_CACHE_SIZE];
+static uint16_t        paletteCacheClock = 0;
+
 CRGBPalette16 &Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
   if (pal < 245 && pal > GRADIENT_PALETTE_COUNT+13) pal = 0;
   if (pal > 245 && (customPalettes.size() == 0 || 255U-pal > customPalettes.size()-1)) pal = 0;
@@ -250,9 +286,21 @@ CRGBPalette16 &Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
       } else if (pal < 13) { // palette 6 - 12, fastled palettes
         targetPalette = *fastledPalettes[pal-6];
       } else {
-        byte tcp[72];
-        memcpy_P(tcp, (byte*)pgm_read_dword(&(gGradientPalettes[pal-13])), 72);
-        targetPalette.loadDynamicGradientPalette(tcp);
+        // gradient palettes are decoded once and kept in a small LRU cache (loadPalette() runs for each segment in each frame)
+        palette_cache_t *entry = nullptr, *lru = &paletteCache[0];
+        for (palette_cache_t &c : paletteCache) {
+          if (c.id == pal) { entry = &c; break; }
+          if (lru->id && (!c.id || uint16_t(paletteCacheClock - c.lastUsed) > uint16_t(paletteCacheClock - lru->lastUsed))) lru = &c; // prefer empty slot
+        }
+        if (!entry) {
+          entry = lru;
+          byte tcp[72];
+          memcpy_P(tcp, (byte*)pgm_read_dword(&(gGradientPalettes[pal-13])), 72);
+          entry->palette.loadDynamicGradientPalette(tcp);
+          entry->id = pal;
+        }
+        entry->lastUsed = ++paletteCacheClock;
+        targetPalette = entry->palette;
       }
       break;
   }
@@ -367,8 +415,23 @@ void Segment::beginDraw(uint16_t prog) {
     Segment::_currentPalette = tmpPalette; // copy transitioning/temporary palette
     #endif
   }
+  #ifdef WLED_PALETTE_LUT
+  // invalidate palette LUT only if palette changed (segments sharing a palette or static palettes keep it across frames)
+  if (Segment::_paletteLUTSource != Segment::_currentPalette) {
+    Segment::_paletteLUTSource = Segment::_currentPalette;
+    Segment::_paletteLUTType = 0;
+  }
+  #endif
 }
 
+#ifdef WLED_PALETTE_LUT
+void Segment::buildPaletteLUT(uint8_t type) {
+  const TBlendType blend = type == 2 ? NOBLEND : LINEARBLEND;
+  for (unsigned i = 0; i < 256; i++) _paletteLUT[i] = ColorFromPalette(_currentPalette, i, 255, blend);
+  _paletteLUTType = type;
+}
+#endif
+
 // relies on WS2812FX::service() to call it for each frame
 void Segment::handleRandomPalette() {
   unsigned long now = millis();
@@ -1029,32 +1092,13 @@ void Segment::blur(uint8_t blur_amount, bool smear) const {
   if (is2D()) {
     // compatibility with 2D
     blur2D(blur_amount, blur_amount, smear); // symmetrical 2D blur
-    //box_blur(map(blur_amount,1,255,1,3), smear);
+    //box_blur(map(blur_amount,1,255,1,3));
     return;
   }
 #endif
   uint8_t keep = smear ? 255 : 255 - blur_amount;
   uint8_t seep = blur_amount >> 1;
-  unsigned vlength = vLength();
-  uint32_t carryover = BLACK;
-  uint32_t lastnew; // not necessary to initialize lastnew and last, as both will be initialized by the first loop iteration
-  uint32_t last;
-  uint32_t curnew = BLACK;
-  for (unsigned i = 0; i < vlength; i++) {
-    uint32_t cur = getPixelColorRaw(i);
-    uint32_t part = color_fade(cur, seep);
-    curnew = color_fade(cur, keep);
-    if (i > 0) {
-      if (carryover) curnew = color_add(curnew, carryover);
-      uint32_t prev = color_add(lastnew, part);
-      // optimization: only set pixel if color has changed
-      if (last != prev) setPixelColorRaw(i - 1, prev);
-    } else setPixelColorRaw(i, curnew); // first pixel
-    lastnew = curnew;
-    last = cur; // save original value for comparison on next iteration
-    carryover = part;
-  }
-  setPixelColorRaw(vlength - 1, curnew);
+  blurLine(pixels, vLength(), 1, keep, seep);
 }
 
 /*
@@ -1102,6 +1146,13 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
   unsigned paletteIndex = i;
   if (mapping) paletteIndex = min((i*255)/vLength(), 255U);
   // paletteBlend: 0 - wrap when moving, 1 - always wrap, 2 - never wrap, 3 - none (undefined/no interpolation of palette entries)
+  #ifdef WLED_PALETTE_LUT
+  // LINEARBLEND_NOWRAP is LINEARBLEND with remapped index (see ColorFromPaletteWLED()) so a single table covers it
+  const uint8_t lutType = paletteBlend == 3 ? 2 : 1;
+  if (_paletteLUTType != lutType) buildPaletteLUT(lutType);
+  if (paletteBlend == 2 || (paletteBlend == 0 && !moving)) paletteIndex = (paletteIndex * 0xF0) >> 8;
+  return (color_fade(_paletteLUT[byte(paletteIndex)], pbri) & 0x00FFFFFF) | (color & 0xFF000000);
+  #else
   // ColorFromPalette interpolations are: NOBLEND, LINEARBLEND, LINEARBLEND_NOWRAP
   TBlendType blend = NOBLEND;
   switch (paletteBlend) {
@@ -1113,6 +1164,7 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
   palcol.w = W(color);
 
   return palcol.color32;
+  #endif
 }
 
 
@@ -1195,16 +1247,66 @@ void WS2812FX::finalizeInit() {
   DEBUG_PRINTF_P(PSTR("Heap after strip init: %uB\n"), ESP.getFreeHeap());
 }
 
+#ifdef WLED_ENABLE_PERF
+perf_data_t perfData;
+
+void perfAddMode(uint8_t id, uint32_t t) {
+  unsigned long nowMs = millis();
+  perf_mode_t *slot = &perfData.mode[0];
+  for (perf_mode_t &pm : perfData.mode) {
+    if (pm.lastUsed && pm.id == id) { slot = &pm; break; } // found
+    if (pm.lastUsed < slot->lastUsed) slot = &pm;           // least recently used (or empty) slot
+  }
+  if (!slot->lastUsed || slot->id != id) { slot->fx.reset(); slot->id = id; } // new entry
+  slot->lastUsed = nowMs ? nowMs : 1;
+  slot->fx.add(t);
+}
+
+void perfAllocData(size_t len, bool ok) {
+  if (Segment::getUsedSegmentData() > perfData.dataPeak) perfData.dataPeak = Segment::getUsedSegmentData();
+  if (!strip.isServicing() || strip.getCurrSegmentId() >= MAX_NUM_SEGMENTS) return; // not called from an effect
+  perf_segment_t &ps = perfData.seg[strip.getCurrSegmentId()];
+  if (len > ps.dataLen) ps.dataLen = len;
+  if (!ok && ps.dataFail < 0xFFFF) ps.dataFail++;
+}
+
+void perfRoll() {
+  if (millis() - perfData.windowStart < WLED_PERF_WINDOW) return;
+  perfData.windowStart = millis();
+  perfData.service.roll();
+  perfData.show.roll();
+  perfData.bus.roll();
+  for (perf_segment_t &ps : perfData.seg) { ps.fx.roll(); ps.fxOld.roll(); ps.blend.roll(); }
+  for (perf_mode_t &pm : perfData.mode)   pm.fx.roll();
+  BusManager::rollTimings();
+}
+#endif
+
+// frame budget scheduler: while frames take longer than frame time, expensive segments other than main segment
+// are asked for reduced quality (Segment::isReducedQuality()), skip old effect during transition and update less often
+#ifndef WLED_THROTTLE_MAX
+  #define WLED_THROTTLE_MAX  3  // highest scheduler level
+#endif
+#define WLED_THROTTLE_HOLD  32  // frames that need to be well within budget before level is lowered
+
 void WS2812FX::service() {
   unsigned long nowUp = millis(); // Be aware, millis() rolls over every 49 days
   now = nowUp + timebase;
   unsigned long elapsed = nowUp - _lastServiceShow;
-  if (_suspend || elapsed <= MIN_FRAME_DELAY) return;   // keep wifi alive - no matter if triggered or unlimited
+  if (_suspend) return;
+  BusManager::showPending();                            // changes buses could not take with last frame (busy or own max FPS)
+  if (elapsed <= MIN_FRAME_DELAY) return;               // keep wifi alive - no matter if triggered or unlimited
   if (!_triggered && (_targetFps != FPS_UNLIMITED)) {   // unlimited mode = no frametime
     if (elapsed < _frametime) return;                   // too early for service
   }
+  unsigned long serviceStart = micros();
+  #ifdef WLED_ENABLE_PERF
+  perfRoll();
+  #endif
 
   bool doShow = false;
+  // segments above this cost (in us) are degraded (1/8 of frame time at level 1, 1/16 at level 2, ...)
+  const unsigned costLimit = (_frametime * 1000U) >> (2 + _throttle);
 
   _isServicing = true;
   _segment_index = 0;
@@ -1235,22 +1337,46 @@ void WS2812FX::service() {
         uint16_t prog = seg.progress();
         seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
         _currentSegment = &seg;             // set current segment for effect functions (SEGMENT & SEGENV)
+        #ifdef WLED_ENABLE_PERF
+        perf_segment_t &ps = perfData.seg[_segment_index];
+        if (ps.mode != seg.mode) { ps.fx.reset(); ps.fxOld.reset(); ps.blend.reset(); ps.dataLen = ps.dataFail = 0; ps.mode = seg.mode; }
+        #endif
+        const bool degrade = _throttle && _segment_index != _mainSegment && seg._cost >= costLimit;
+        Segment::_reducedQuality = degrade;
+        unsigned long fxStart = micros();
         // workaround for on/off transition to respect blending style
         frameDelay = (*_mode[seg.mode])();  // run new/current mode (needed for bri workaround)
+        unsigned long fxTime = micros() - fxStart;
+        #ifdef WLED_ENABLE_PERF
+        ps.fx.add(fxTime);
+        perfAddMode(seg.mode, fxTime);
+        #endif
         seg.call++;
         // if segment is in transition and no old segment exists we don't need to run the old mode
         // (blendSegments() takes care of On/Off transitions and clipping)
+        // degraded segment keeps old mode's last frame for blending
         Segment *segO = seg.getOldSegment();
-        if (segO && (seg.mode != segO->mode || blendingStyle != BLEND_STYLE_FADE)) {
+        if (segO && !degrade && (seg.mode != segO->mode || blendingStyle != BLEND_STYLE_FADE)) {
           Segment::modeBlend(true);         // set semaphore for beginDraw() to blend colors and palette
           segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
           _currentSegment = segO;           // set current segment
+          fxStart = micros();
           // workaround for on/off transition to respect blending style
           frameDelay = min(frameDelay, (unsigned)(*_mode[segO->mode])());  // run old mode (needed for bri workaround; semaphore!!)
+          unsigned long fxTimeO = micros() - fxStart;
+          #ifdef WLED_ENABLE_PERF
+          ps.fxOld.add(fxTimeO);
+          perfAddMode(segO->mode, fxTimeO);
+          #endif
+          fxTime += fxTimeO;
           segO->call++;                     // increment old mode run counter
           Segment::modeBlend(false);        // unset semaphore
         }
+        Segment::_reducedQuality = false;
+        // keep cost of full quality rendering (a degraded segment would otherwise look cheap and be restored immediately)
+        if (!degrade) seg._cost = (7U * seg._cost + min(fxTime, 0xFFFFUL)) >> 3;
         if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
+        if (degrade && _throttle > 1) frameDelay *= _throttle; // lower update rate of background segment
         BusManager::setSegmentCCT(oldCCT);  // restore old CCT for ABL adjustments
       }
 
@@ -1258,6 +1384,12 @@ void WS2812FX::service() {
     }
     _segment_index++;
   }
+  #ifndef WLED_DISABLE_2D
+  purgeGeometry2D(); // release geometry tables no longer used by any effect
+  #endif
+  #ifndef WLED_DISABLE_PARTICLESYSTEM2D
+  purgeParticleBuffers(); // release particle render kernels and collision grid no longer used by any effect
+  #endif
 
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
@@ -1271,6 +1403,21 @@ void WS2812FX::service() {
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow strip %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
   #endif
+  if (doShow && !_suspend) {
+    unsigned long used = micros() - serviceStart;
+    #ifdef WLED_ENABLE_PERF
+    perfData.service.add(used);
+    #endif
+    // adjust frame budget scheduler level (raise immediately, lower only after a while well within budget)
+    const unsigned long budget = _frametime * 1000UL;
+    if (_targetFps == FPS_UNLIMITED || _segments.size() < 2) _throttle = 0;
+    else if (used > budget) {
+      if (_throttle < WLED_THROTTLE_MAX) _throttle++;
+      _lightFrames = 0;
+    } else if (_throttle && used < budget/2) {
+      if (++_lightFrames >= WLED_THROTTLE_HOLD) { _throttle--; _lightFrames = 0; }
+    } else _lightFrames = 0;
+  }
 
   _triggered = false;
   _isServicing = false;
@@ -1525,67 +1672,10 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
   Segment::setClippingRect(0, 0);             // disable clipping for overlays
 }
 
-// To disable brightness limiter we either set output max current to 0 or single LED current to 0
-static uint8_t estimateCurrentAndLimitBri(uint8_t brightness, uint32_t *pixels) {
-  unsigned milliAmpsMax = BusManager::ablMilliampsMax();
-  if (milliAmpsMax > 0) {
-    unsigned milliAmpsTotal = 0;
-    unsigned avgMilliAmpsPerLED = 0;
-    unsigned lengthDigital = 0;
-    bool useWackyWS2815PowerModel = false;
-
-    for (size_t i = 0; i < BusManager::getNumBusses(); i++) {
-      const Bus *bus = BusManager::getBus(i);
-      if (!(bus && bus->isDigital() && bus->isOk())) continue;
-      unsigned maPL = bus->getLEDCurrent();
-      if (maPL == 0 || bus->getMaxCurrent() > 0) continue; // skip buses with 0 mA per LED or max current per bus defined (PP-ABL)
-      if (maPL == 255) {
-        useWackyWS2815PowerModel = true;
-        maPL = 12; // WS2815 uses 12mA per channel
-      }
-      avgMilliAmpsPerLED += maPL * bus->getLength();
-      lengthDigital += bus->getLength();
-      // sum up the usage of each LED on digital bus
-      uint32_t busPowerSum = 0;
-      for (unsigned j = 0; j < bus->getLength(); j++) {
-        uint32_t c = pixels[j + bus->getStart()];
-        byte r = R(c), g = G(c), b = B(c), w = W(c);
-        if (useWackyWS2815PowerModel) { //ignore white component on WS2815 power calculation
-          busPowerSum += (max(max(r,g),b)) * 3;
-        } else {
-          busPowerSum += (r + g + b + w);
-        }
-      }
-      // RGBW led total output with white LEDs enabled is still 50mA, so each channel uses less
-      if (bus->hasWhite()) {
-        busPowerSum *= 3;
-        busPowerSum >>= 2; //same as /= 4
-      }
-      // powerSum has all the values of channels summed (max would be getLength()*765 as white is excluded) so convert to milliAmps
-      milliAmpsTotal += (busPowerSum * maPL * brightness) / (765*255);
-    }
-    if (lengthDigital > 0) {
-      avgMilliAmpsPerLED /= lengthDigital;
-
-      if (milliAmpsMax > MA_FOR_ESP && avgMilliAmpsPerLED > 0) { //0 mA per LED and too low numbers turn off calculation
-        unsigned powerBudget = (milliAmpsMax - MA_FOR_ESP); //80/120mA for ESP power
-        if (powerBudget > lengthDigital) { //each LED uses about 1mA in standby, exclude that from power budget
-          powerBudget -= lengthDigital;
-        } else {
-          powerBudget = 0;
-        }
-        if (milliAmpsTotal > powerBudget) {
-          //scale brightness down to stay in current limit
-          unsigned scaleB = powerBudget * 255 / milliAmpsTotal;
-          brightness = ((brightness * scaleB) >> 8) + 1;
-        }
-      }
-    }
-  }
-  return brightness;
-}
-
 void WS2812FX::show() {
+  #ifdef WLED_ENABLE_PERF
+  unsigned long perfShow = micros();
+  #endif
   unsigned long showNow = millis();
   size_t diff = showNow - _lastShow;
 
@@ -1595,7 +1685,14 @@ void WS2812FX::show() {
     for (size_t i = 0; i < totalLen; i++) _pixels[i] = BLACK; // memset(_pixels, 0, sizeof(uint32_t) * getLengthTotal());
     // blend all segments into (cleared) buffer
     for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition())) {
+      #ifdef WLED_ENABLE_PERF
+      unsigned long perfStart = micros();
+      #endif
       blendSegment(seg);              // blend segment's buffer into frame buffer
+      #ifdef WLED_ENABLE_PERF
+      size_t idx = &seg - _segments.data();
+      if (idx < MAX_NUM_SEGMENTS) perfData.seg[idx].blend.add(micros() - perfStart);
+      #endif
     }
   }
 
@@ -1603,17 +1700,52 @@ void WS2812FX::show() {
   show_callback callback = _callback;
   if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
 
-  // determine ABL brightness
-  uint8_t newBri = estimateCurrentAndLimitBri(_brightness, _pixels);
-  if (newBri != _brightness) BusManager::setBrightness(newBri);
-
   // paint actuall pixels
-  for (size_t i = 0; i < totalLen; i++) BusManager::setPixelColor(getMappedPixelIndex(i), realtimeMode && arlsDisableGammaCorrection ? _pixels[i] : gamma32(_pixels[i]));
+  const bool noGamma = realtimeMode && arlsDisableGammaCorrection;
+  const bool useMap  = customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps);
+  // ABL: global, PSU group and per bus limited brightness is derived from power buses collected while painting previous frame
+  const uint8_t newBri = BusManager::applyCurrentLimits(_brightness);
+
+  // consecutive pixels are gamma corrected into a small buffer and handed over to buses in bulk
+  uint32_t chunk[SHOW_CHUNK_SIZE];
+  auto paint = [&](unsigned target, size_t i, size_t n) {
+    while (n) {
+      const size_t len = min(n, (size_t)SHOW_CHUNK_SIZE);
+      for (size_t k = 0; k < len; k++) chunk[k] = noGamma ? _pixels[i+k] : gamma32(_pixels[i+k]);
+      BusManager::setPixels(target, chunk, len, noGamma ? nullptr : &_pixels[i]); // buses may apply gamma with higher precision
+      target += len; i += len; n -= len;
+    }
+  };
+  auto paintPixel = [&](unsigned target, size_t i) {
+    uint32_t c = noGamma ? _pixels[i] : gamma32(_pixels[i]);
+    BusManager::setPixels(target, &c, 1, noGamma ? nullptr : &_pixels[i]);
+  };
+  if (useMap && customMappingRuns) {
+    // compiled ledmap: walk runs instead of looking up each pixel
+    for (unsigned r = 0; r < customMappingRunCount; r++) {
+      const ledmap_run_t &run = customMappingRuns[r];
+      if (run.target == 0xFFFF) continue; // missing pixels
+      if (run.stride == 1) { paint(run.target, run.start, run.len); continue; }
+      int target = run.target;
+      for (size_t i = run.start; i < run.start + run.len; i++, target += run.stride) paintPixel(target, i);
+    }
+    if (totalLen > customMappingSize) paint(customMappingSize, customMappingSize, totalLen - customMappingSize);
+  } else if (useMap) {
+    for (size_t i = 0; i < totalLen; i++) paintPixel(getMappedPixelIndex(i), i);
+  } else {
+    paint(0, 0, totalLen);
+  }
 
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
+  #ifdef WLED_ENABLE_PERF
+  unsigned long perfBus = micros();
+  BusManager::show();
+  perfData.bus.add(micros() - perfBus);
+  #else
   BusManager::show();
+  #endif
 
   // restore brightness for next frame
   if (newBri != _brightness) BusManager::setBrightness(_brightness);
@@ -1623,6 +1755,9 @@ void WS2812FX::show() {
     _cumulativeFps = (FPS_CALC_AVG * _cumulativeFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);   // "+FPS_CALC_AVG/2" for proper rounding
     _lastShow = showNow;
   }
+  #ifdef WLED_ENABLE_PERF
+  perfData.show.add(micros() - perfShow);
+  #endif
 }
 
 void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
@@ -1914,29 +2049,156 @@ void WS2812FX::printSize() {
   for (const Segment &seg : _segments) DEBUG_PRINTF_P(PSTR("  Seg: %d,%d [A=%d, 2D=%d, RGB=%d, W=%d, CCT=%d]\n"), seg.width(), seg.height(), seg.isActive(), seg.is2D(), seg.hasRGB(), seg.hasWhite(), seg.isCCT());
   DEBUG_PRINTF_P(PSTR("Modes: %d*%d=%uB\n"), sizeof(mode_ptr), _mode.size(), (_mode.capacity()*sizeof(mode_ptr)));
   DEBUG_PRINTF_P(PSTR("Data: %d*%d=%uB\n"), sizeof(const char *), _modeData.size(), (_modeData.capacity()*sizeof(const char *)));
-  DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
+  if (customMappingRuns) DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB (%d LEDs)\n"), sizeof(ledmap_run_t), (int)customMappingRunCount, customMappingRunCount*sizeof(ledmap_run_t), (int)customMappingSize);
+  else                   DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
 }
 #endif
 
-// load custom mapping table from JSON file (called from finalizeInit() or deserializeState())
-// if this is a matrix set-up and default ledmap.json file does not exist, create mapping table using setUpMatrix() from panel information
+void WS2812FX::releaseMap() {
+  d_free(customMappingTable);
+  d_free(customMappingRuns);
+  customMappingTable = nullptr;
+  customMappingRuns = nullptr;
+  customMappingRunCount = 0;
+}
+
+// compile customMappingTable into runs of equally spaced physical indices (serpentine panels, hand made ledmaps)
+// the per-pixel table is released if runs need less memory, otherwise it is kept
+// must be called while strip is suspended
+void WS2812FX::compileMap() {
+  d_free(customMappingRuns);
+  customMappingRuns = nullptr;
+  customMappingRunCount = 0;
+  if (!customMappingTable || !customMappingSize) return;
+
+  // pass 0 counts runs, pass 1 fills them
+  unsigned runs = 0;
+  for (unsigned pass = 0; pass < 2; pass++) {
+    ledmap_run_t run = {0, customMappingTable[0], 1, 0};
+    runs = 0;
+    for (unsigned i = 1; i < customMappingSize; i++) {
+      const uint16_t target = customMappingTable[i];
+      bool extends;
+      if (run.len == 1) {
+        extends = (run.target == 0xFFFF) == (target == 0xFFFF); // missing pixels never mix with present ones
+        if (extends) run.stride = int(target) - int(run.target);
+      } else {
+        extends = int(run.target) + int(run.len) * run.stride == int(target);
+      }
+      if (extends && run.len < 0xFFFF) run.len++;
+      else {
+        if (pass) customMappingRuns[runs] = run;
+        runs++;
+        run = {uint16_t(i), target, 1, 0};
+      }
+    }
+    if (pass) customMappingRuns[runs] = run;
+    runs++;
+
+    if (!pass) {
+      if (runs * sizeof(ledmap_run_t) >= customMappingSize * sizeof(uint16_t)) return; // table is smaller, keep it
+      customMappingRuns = static_cast<ledmap_run_t*>(d_malloc(runs * sizeof(ledmap_run_t))); // do not use SPI RAM
+      if (!customMappingRuns) return;
+    }
+  }
+  customMappingRunCount = runs;
+  d_free(customMappingTable);
+  customMappingTable = nullptr;
+  DEBUG_PRINTF_P(PSTR("Ledmap compiled into %u runs.\n"), runs);
+}
+
+// binary search for run containing index (runs cover [0, customMappingSize) in ascending order)
+uint16_t WS2812FX::getMappedRunIndex(uint16_t index) const {
+  unsigned lo = 0, hi = customMappingRunCount;
+  while (hi - lo > 1) {
+    unsigned mid = (lo + hi) >> 1;
+    if (customMappingRuns[mid].start <= index) lo = mid;
+    else hi = mid;
+  }
+  const ledmap_run_t &run = customMappingRuns[lo];
+  return run.target + (int(index) - int(run.start)) * run.stride;
+}
+
+// load custom mapping table from binary file (ledmapN.bin, see ledmap_bin_t)
+// entries are stored as little endian uint16_t so they are read directly into customMappingTable in a single block
+bool WS2812FX::deserializeBinaryMap(const char *fileName, unsigned n) {
+  File f = WLED_FS.open(fileName, "r");
+  if (!f) return false;
+
+  ledmap_bin_t hdr;
+  if (f.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) != sizeof(hdr) || hdr.magic != LEDMAP_BIN_MAGIC || hdr.version != LEDMAP_BIN_VERSION ||
+      f.size() < sizeof(hdr) + hdr.nameLen + hdr.count * sizeof(uint16_t) || !f.seek(sizeof(hdr) + hdr.nameLen)) {
+    DEBUG_PRINTF_P(PSTR("ERROR Invalid ledmap in %s\n"), fileName);
+    f.close();
+    return false;
+  }
+  DEBUG_PRINTF_P(PSTR("Reading LED map from %s\n"), fileName);
+
+  suspend();
+  waitForIt();
+
+  // if we are loading default ledmap (at boot) set matrix width and height from the ledmap
+  if (n == 0 && (hdr.width || hdr.height)) {
+    Segment::maxWidth  = min(max((int)hdr.width, 1), 255);
+    Segment::maxHeight = min(max((int)hdr.height, 1), 255);
+    isMatrix = true;
+  }
+
+  releaseMap();
+  customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // do not use SPI RAM
+
+  if (customMappingTable) {
+    unsigned count = min((unsigned)hdr.count, (unsigned)getLengthTotal());
+    size_t bytes = count * sizeof(uint16_t);
+    if (f.read(reinterpret_cast<uint8_t*>(customMappingTable), bytes) == bytes) {
+      for (unsigned i = 0; i < count; i++) if (customMappingTable[i] > 16384) customMappingTable[i] = 0xFFFF; // same limit as JSON ledmap
+      customMappingSize = count;
+      currentLedmap = n;
+      DEBUG_PRINTF_P(PSTR("Loaded ledmap: %u entries\n"), count);
+      compileMap();
+    }
+  } else {
+    DEBUG_PRINTLN(F("ERROR LED map allocation error."));
+  }
+
+  resume();
+  f.close();
+  return (customMappingSize > 0);
+}
+
+// load custom mapping table from binary or JSON file (called from finalizeInit() or deserializeState())
+// ledmapN.bin takes precedence, ledmapN.json is used as a fallback (if binary file is missing or invalid)
+// if this is a matrix set-up and default ledmap file does not exist, create mapping table using setUpMatrix() from panel information
 bool WS2812FX::deserializeMap(unsigned n) {
   char fileName[32];
   strcpy_P(fileName, PSTR("/ledmap"));
   if (n) sprintf(fileName +7, "%d", n);
-  strcat_P(fileName, PSTR(".json"));
-  bool isFile = WLED_FS.exists(fileName);
+  size_t extPos = strlen(fileName);
+  strcpy_P(fileName + extPos, PSTR(".bin"));
+  bool isBinary = WLED_FS.exists(fileName);
+  if (!isBinary) strcpy_P(fileName + extPos, PSTR(".json"));
+  bool isFile = isBinary || WLED_FS.exists(fileName);
 
   customMappingSize = 0; // prevent use of mapping if anything goes wrong
   currentLedmap = 0;
   if (n == 0 || isFile) interfaceUpdateCallMode = CALL_MODE_WS_SEND; // schedule WS update (to inform UI)
 
   if (!isFile && n==0 && isMatrix) {
-    // 2D panel support creates its own ledmap (on the fly) if a ledmap.json does not exist
+    // 2D panel support creates its own ledmap (on the fly) if a ledmap file does not exist
     setUpMatrix();
     return false;
   }
 
+  if (isBinary) {
+    if (deserializeBinaryMap(fileName, n)) return true;
+    strcpy_P(fileName + extPos, PSTR(".json")); // fall back to JSON ledmap
+    isFile = WLED_FS.exists(fileName);
+    if (!isFile && n==0 && isMatrix) {
+      setUpMatrix();
+      return false;
+    }
+  }
+
   if (!isFile || !requestJSONBufferLock(7)) return false;
 
   StaticJsonDocument<64> filter;
@@ -1960,7 +2222,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
     isMatrix = true;
   }
 
-  d_free(customMappingTable);
+  releaseMap();
   customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // do not use SPI RAM
 
   if (customMappingTable) {
@@ -1983,7 +2245,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
         int index = atoi(number);
         if (index < 0 || index > 16384) index = 0xFFFF;
         customMappingTable[customMappingSize++] = index;
-        if (customMappingSize > getLengthTotal()) break;
+        if (customMappingSize >= getLengthTotal()) break;
       } else break; // there was nothing to read, stop
     }
     currentLedmap = n;
@@ -1997,6 +2259,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
     }
     DEBUG_PRINTLN();
     #endif
+    compileMap();
 /*
     JsonArray map = root[F("map")];
     if (!map.isNull() && map.size()) {  // not an empty map
@@ -28,6 +28,7 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   numSources = numberofsources; // number of sources allocated in init
   numParticles = numberofparticles; // number of particles allocated in init
   usedParticles = numParticles; // use all particles by default
+  activeParticles = numParticles;
   advPartProps = nullptr; //make sure we start out with null pointers (just in case memory was not cleared)
   advPartSize = nullptr;
   setMatrixSize(width, height);
@@ -39,7 +40,6 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   motionBlur = 0; //no fading by default
   smearBlur = 0; //no smearing by default
   emitIndex = 0;
-  collisionStartIdx = 0;
 
   //initialize some default non-zero values most FX use
   for (uint32_t i = 0; i < numParticles; i++) {
@@ -55,16 +55,18 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
 
 // update function applies gravity, moves the particles, handles collisions and renders the particles
 void ParticleSystem2D::update(void) {
-  //apply gravity globally if enabled
-  if (particlesettings.useGravity)
-    applyGravity();
+  updateActiveParticles(); // FX may have revived particles by setting their ttl
 
-  //update size settings before handling collisions
-  if (advPartSize) {
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (updateSize(&advPartProps[i], &advPartSize[i]) == false) { // if particle shrinks to 0 size
+  // apply gravity and update size settings (before handling collisions) in one pass
+  int32_t dv = 0;
+  if (particlesettings.useGravity)
+    dv = calcForce_dv(gforce, gforcecounter);
+  if (dv || advPartSize) {
+    for (uint32_t i = 0; i < activeParticles; i++) {
+      // Note: not checking if particle is dead is faster as most are usually alive (dead ones are compacted to the end)
+      particles[i].vy = limitSpeed((int32_t)particles[i].vy - dv);
+      if (advPartSize && updateSize(&advPartProps[i], &advPartSize[i]) == false) // if particle shrinks to 0 size
         particles[i].ttl = 0; // kill particle
-      }
     }
   }
 
@@ -73,15 +75,41 @@ void ParticleSystem2D::update(void) {
     handleCollisions();
 
   //move all particles
-  for (uint32_t i = 0; i < usedParticles; i++) {
+  for (uint32_t i = 0; i < activeParticles; i++) {
+    if (particles[i].ttl == 0) continue; // skip dead particles without a function call
     particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr); // note: splitting this into two loops is slower and uses more flash
   }
 
+  compactParticles();
   render();
 }
 
+// move live particles from the end into slots of dead ones so all live particles are below activeParticles and loops can stop there
+// perpetual particles are never moved (FX keep them alive at a fixed index)
+void ParticleSystem2D::compactParticles() {
+  uint32_t j = activeParticles;
+  for (uint32_t i = 0; i < j; i++) {
+    if (particles[i].ttl) continue;
+    do { j--; } while (j > i && (particles[j].ttl == 0 || particleFlags[j].perpetual)); // last movable live particle
+    if (j <= i) break;
+    particles[i] = particles[j];
+    particleFlags[i] = particleFlags[j];
+    if (advPartProps) advPartProps[i] = advPartProps[j];
+    if (advPartSize) advPartSize[i] = advPartSize[j];
+    particles[j].ttl = 0;
+  }
+  updateActiveParticles();
+}
+
+// find end of live particles (all particles at or above activeParticles are dead)
+void ParticleSystem2D::updateActiveParticles() {
+  activeParticles = usedParticles;
+  while (activeParticles > 0 && particles[activeParticles - 1].ttl == 0) activeParticles--;
+}
+
 // update function for fire animation
 void ParticleSystem2D::updateFire(const uint8_t intensity,const bool renderonly) {
+  updateActiveParticles(); // fire particles are not compacted, only dead ones at the end are skipped
   if (!renderonly)
     fireParticleupdate();
   fireIntesity = intensity > 0 ? intensity : 1; // minimum of 1, zero checking is used in render function
@@ -91,6 +119,7 @@ void ParticleSystem2D::updateFire(const uint8_t intensity,const bool renderonly)
 // set percentage of used particles as uint8_t i.e 127 means 50% for example
 void ParticleSystem2D::setUsedParticles(uint8_t percentage) {
   usedParticles = (numParticles * ((int)percentage+1)) >> 8; // number of particles to use (percentage is 0-255, 255 = 100%)
+  activeParticles = usedParticles; // particles above previous limit may still be alive
   PSPRINT(" SetUsedpaticles: allocated particles: ");
   PSPRINT(numParticles);
   PSPRINT(" ,used particles: ");
@@ -198,6 +227,7 @@ int32_t ParticleSystem2D::sprayEmit(const PSsource &emitter) {
       particles[emitIndex].ttl = hw_random16(emitter.minLife, emitter.maxLife);
       if (advPartProps)
         advPartProps[emitIndex].size = emitter.size;
+      if (emitIndex >= activeParticles) activeParticles = emitIndex + 1;
       break;
     }
   }
@@ -238,17 +268,15 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
     int32_t newY = part.y + (int32_t)part.vy;
     partFlags.outofbounds = false; // reset out of bounds (in case particle was created outside the matrix and is now moving into view) note: moving this to checks below adds code and is not faster
 
-    if (advancedproperties) { //using individual particle size?
-      setParticleSize(particlesize); // updates default particleHardRadius
-      if (advancedproperties->size > PS_P_MINHARDRADIUS) {
-        particleHardRadius += (advancedproperties->size - PS_P_MINHARDRADIUS); // update radius
-        renderradius = particleHardRadius;
-      }
+    uint32_t hardRadius = particleHardRadius; // global radius (set by setParticleSize())
+    if (advancedproperties && advancedproperties->size > PS_P_MINHARDRADIUS) { //using individual particle size?
+      hardRadius += (advancedproperties->size - PS_P_MINHARDRADIUS); // individual radius
+      renderradius = hardRadius;
     }
     // note: if wall collisions are enabled, bounce them before they reach the edge, it looks much nicer if the particle does not go half out of view
     if (options->bounceY) {
-      if ((newY < (int32_t)particleHardRadius) || ((newY > (int32_t)(maxY - particleHardRadius)) && !options->useGravity)) { // reached floor / ceiling
-         bounce(part.vy, part.vx, newY, maxY);
+      if ((newY < (int32_t)hardRadius) || ((newY > (int32_t)(maxY - hardRadius)) && !options->useGravity)) { // reached floor / ceiling
+         bounce(part.vy, part.vx, newY, maxY, hardRadius);
       }
     }
 
@@ -264,8 +292,8 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
 
     if (part.ttl) { //check x direction only if still alive
       if (options->bounceX) {
-        if ((newX < (int32_t)particleHardRadius) || (newX > (int32_t)(maxX - particleHardRadius))) // reached a wall
-          bounce(part.vx, part.vy, newX, maxX);
+        if ((newX < (int32_t)hardRadius) || (newX > (int32_t)(maxX - hardRadius))) // reached a wall
+          bounce(part.vx, part.vy, newX, maxX, hardRadius);
       }
       else if (!checkBoundsAndWrap(newX, maxX, renderradius, options->wrapX)) { // check out of bounds
         partFlags.outofbounds = true;
@@ -281,7 +309,7 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
 
 // move function for fire particles
 void ParticleSystem2D::fireParticleupdate() {
-  for (uint32_t i = 0; i < usedParticles; i++) {
+  for (uint32_t i = 0; i < activeParticles; i++) {
     if (particles[i].ttl > 0)
     {
       particles[i].ttl--; // age
@@ -386,13 +414,13 @@ void ParticleSystem2D::getParticleXYsize(PSadvancedParticle *advprops, PSsizeCon
 }
 
 // function to bounce a particle from a wall using set parameters (wallHardness and wallRoughness)
-void ParticleSystem2D::bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition) {
+void ParticleSystem2D::bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition, const uint32_t hardRadius) {
   incomingspeed = -incomingspeed;
   incomingspeed = (incomingspeed * wallHardness + 128) >> 8; // reduce speed as energy is lost on non-hard surface
-  if (position < (int32_t)particleHardRadius)
-    position = particleHardRadius; // fast particles will never reach the edge if position is inverted, this looks better
+  if (position < (int32_t)hardRadius)
+    position = hardRadius; // fast particles will never reach the edge if position is inverted, this looks better
   else
-    position = maxposition - particleHardRadius;
+    position = maxposition - hardRadius;
   if (wallRoughness) {
     int32_t incomingspeed_abs = abs((int32_t)incomingspeed);
     int32_t totalspeed = incomingspeed_abs + abs((int32_t)parallelspeed);
@@ -435,15 +463,19 @@ void ParticleSystem2D::applyForce(const uint32_t particleindex, const int8_t xfo
 
 // apply a force in x,y direction to all particles
 // force is in 3.4 fixed point notation (see above)
+// all particles share the global counter so velocity change is the same for all of them and is calculated only once
 void ParticleSystem2D::applyForce(const int8_t xforce, const int8_t yforce) {
-  // for small forces, need to use a delay counter
-  uint8_t tempcounter;
-  // note: this is not the most computationally efficient way to do this, but it saves on duplicate code and is fast enough
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    tempcounter = forcecounter;
-    applyForce(particles[i], xforce, yforce, tempcounter);
+  uint8_t xcounter = forcecounter & 0x0F; // lower four bits
+  uint8_t ycounter = forcecounter >> 4;   // upper four bits
+  const int32_t dvx = calcForce_dv(xforce, xcounter);
+  const int32_t dvy = calcForce_dv(yforce, ycounter);
+  forcecounter = (xcounter & 0x0F) | ((ycounter << 4) & 0xF0); // save value back
+  if (dvx == 0 && dvy == 0) return;
+  // note: not checking if particle is dead is faster as most are usually alive (dead ones are compacted to the end)
+  for (uint32_t i = 0; i < activeParticles; i++) {
+    particles[i].vx = limitSpeed((int32_t)particles[i].vx + dvx);
+    particles[i].vy = limitSpeed((int32_t)particles[i].vy + dvy);
   }
-  forcecounter = tempcounter; // save value back
 }
 
 // apply a force in angular direction to single particle
@@ -470,18 +502,6 @@ void ParticleSystem2D::applyAngleForce(const int8_t force, const uint16_t angle)
   applyForce(xforce, yforce);
 }
 
-// apply gravity to all particles using PS global gforce setting
-// force is in 3.4 fixed point notation, see note above
-// note: faster than apply force since direction is always down and counter is fixed for all particles
-void ParticleSystem2D::applyGravity() {
-  int32_t dv = calcForce_dv(gforce, gforcecounter);
-  if (dv == 0) return;
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    // Note: not checking if particle is dead is faster as most are usually alive and if few are alive, rendering is fast anyways
-    particles[i].vy = limitSpeed((int32_t)particles[i].vy - dv);
-  }
-}
-
 // apply gravity to single particle using system settings (use this for sources)
 // function does not increment gravity counter, if gravity setting is disabled, this cannot be used
 void ParticleSystem2D::applyGravity(PSparticle &part) {
@@ -506,18 +526,18 @@ void ParticleSystem2D::applyFriction(PSparticle &part, const int32_t coefficient
   #endif
 }
 
-// apply friction to all particles
-// note: not checking if particle is dead is faster as most are usually alive and if few are alive, rendering is fast anyways
+// apply friction to all live particles
+// note: not checking if particle is dead is faster as most are usually alive (dead ones are compacted to the end)
 void ParticleSystem2D::applyFriction(const int32_t coefficient) {
   #if defined(CONFIG_IDF_TARGET_ESP32C3) || defined(ESP8266) // use bitshifts with rounding instead of division (2x faster)
   int32_t friction = 256 - coefficient;
-  for (uint32_t i = 0; i < usedParticles; i++) {
+  for (uint32_t i = 0; i < activeParticles; i++) {
     particles[i].vx = ((int32_t)particles[i].vx * friction + (((int32_t)particles[i].vx >> 31) & 0xFF)) >> 8; // note: (v>>31) & 0xFF)) extracts the sign and adds 255 if negative for correct rounding using shifts
     particles[i].vy = ((int32_t)particles[i].vy * friction + (((int32_t)particles[i].vy >> 31) & 0xFF)) >> 8;
   }
   #else // division is faster on ESP32, S2 and S3
   int32_t friction = 255 - coefficient;
-  for (uint32_t i = 0; i < usedParticles; i++) {
+  for (uint32_t i = 0; i < activeParticles; i++) {
     particles[i].vx = ((int32_t)particles[i].vx * friction) / 255;
     particles[i].vy = ((int32_t)particles[i].vy * friction) / 255;
   }
@@ -579,7 +599,7 @@ void ParticleSystem2D::render() {
   }
 
   // go over particles and render them to the buffer
-  for (uint32_t i = 0; i < usedParticles; i++) {
+  for (uint32_t i = 0; i < activeParticles; i++) {
     if (particles[i].ttl == 0 || particleFlags[i].outofbounds)
       continue;
     // generate RGB values for particle
@@ -607,6 +627,7 @@ void ParticleSystem2D::render() {
   // apply global size rendering
   if (particlesize > 1) {
     uint32_t passes = particlesize / 64 + 1; // number of blur passes, four passes max
+    if (SEGMENT.isReducedQuality() && passes > 2) passes = 2; // frame budget exceeded: keep size but skip soft edges
     uint32_t bluramount = particlesize;
     uint32_t bitshift = 0;
     for (uint32_t i = 0; i < passes; i++) {
@@ -617,8 +638,8 @@ void ParticleSystem2D::render() {
     }
   }
 
-  // apply 2D blur to rendered frame
-  if (smearBlur) {
+  // apply 2D blur to rendered frame (skipped if frame budget is exceeded)
+  if (smearBlur && !SEGMENT.isReducedQuality()) {
     blur2D(framebuffer, maxXpixel + 1, maxYpixel + 1, smearBlur, smearBlur);
   }
 
@@ -631,6 +652,123 @@ void ParticleSystem2D::render() {
   }
 }
 
+// precomputed splat kernels for large particles (advanced particle size > 1)
+// a kernel is the result of blurring a 10x10 buffer holding four unity impulses (at the four sub-pixel positions of a particle)
+// in separate lanes, rendering a particle is then a weighted sum of the four lanes instead of blurring a buffer for each particle
+// kernels only depend on x and y size so they are shared among particles and particle systems
+// particles whose size has no kernel (all kernels are in use, e.g. random per particle sizes) are blurred individually
+#ifndef PS_SPLAT_CACHE_SIZE
+  #ifdef ESP8266
+    #define PS_SPLAT_CACHE_SIZE 1
+  #else
+    #define PS_SPLAT_CACHE_SIZE 4
+  #endif
+#endif
+#define PS_SPLAT_BUSY    100  // kernels used within 100ms are in use by a running effect and are not evicted
+#define PS_BUFFER_TIMEOUT 2000 // release shared buffers (splat cache, collision grid) if unused for 2s
+
+static PSsplat *splatCache = nullptr; // allocated on first use
+static unsigned long splatLastUsed = 0;
+
+// blur all four lanes of a kernel, same algorithm as blur2D() on a particle render buffer (first row is skipped in x pass)
+static void blurSplat(PSsplat &k, const uint32_t size, const uint32_t xblur, const uint32_t yblur, const uint32_t start) {
+  uint32_t seep = xblur >> 1;
+  for (uint32_t y = start + 1; y < start + size; y++) {
+    uint32_t carryover[4] = {0, 0, 0, 0};
+    for (uint32_t x = start; x < start + size; x++) {
+      uint16_t *w = k.w[x + y * PS_SPLAT_SIZE];
+      for (unsigned l = 0; l < 4; l++) {
+        uint32_t seeppart = (w[l] * seep) >> 8;
+        if (x > 0) {
+          (w - 4)[l] += seeppart; // pixel to the left
+          w[l] += carryover[l];
+        }
+        carryover[l] = seeppart;
+      }
+    }
+  }
+  seep = yblur >> 1;
+  for (uint32_t x = start; x < start + size; x++) {
+    uint32_t carryover[4] = {0, 0, 0, 0};
+    for (uint32_t y = start; y < start + size; y++) {
+      uint16_t *w = k.w[x + y * PS_SPLAT_SIZE];
+      for (unsigned l = 0; l < 4; l++) {
+        uint32_t seeppart = (w[l] * seep) >> 8;
+        if (y > 0) {
+          (w - 4 * PS_SPLAT_SIZE)[l] += seeppart; // pixel below
+          w[l] += carryover[l];
+        }
+        carryover[l] = seeppart;
+      }
+    }
+  }
+}
+
+const PSsplat *ParticleSystem2D::getSplat(uint32_t xsize, uint32_t ysize) {
+  if (!splatCache) {
+    splatCache = static_cast<PSsplat*>(d_calloc(PS_SPLAT_CACHE_SIZE, sizeof(PSsplat)));
+    if (!splatCache) return nullptr;
+  }
+  const unsigned long now = millis();
+  splatLastUsed = now;
+  PSsplat *slot = &splatCache[0];
+  for (unsigned i = 0; i < PS_SPLAT_CACHE_SIZE; i++) {
+    PSsplat &k = splatCache[i];
+    if (k.rendersize && k.xsize == xsize && k.ysize == ysize) {
+      k.lastUsed = now;
+      return &k;
+    }
+    if (slot->rendersize && (!k.rendersize || k.lastUsed < slot->lastUsed)) slot = &k; // free or least recently used
+  }
+  // all kernels are in use: rebuilding one for every particle is slower than blurring the particle itself
+  if (slot->rendersize && now - slot->lastUsed < PS_SPLAT_BUSY) return nullptr;
+
+  // build kernel: unity (255) impulses at bottom left, bottom right, top right and top left
+  PSsplat &k = *slot;
+  memset(k.w, 0, sizeof(k.w));
+  k.w[4 + 4 * PS_SPLAT_SIZE][0] = 255;
+  k.w[5 + 4 * PS_SPLAT_SIZE][1] = 255;
+  k.w[5 + 5 * PS_SPLAT_SIZE][2] = 255;
+  k.w[4 + 5 * PS_SPLAT_SIZE][3] = 255;
+  k.xsize = xsize;
+  k.ysize = ysize;
+  k.lastUsed = now;
+  uint32_t rendersize = 2; // initialize render size, minimum is 4x4 pixels, it is incremented in the loop below to start with 4
+  uint32_t offset = 4; // offset to zero coordinate to write/read data in kernel (actually needs to be 3, is decremented in the loop below)
+  uint32_t passes = max(xsize, ysize) / 64 + 1; // number of blur passes depends on size, four passes max
+  uint32_t bitshift = 0;
+  for (uint32_t i = 0; i < passes; i++) {
+    if (i == 2) //for the last two passes, use higher amount of blur (results in a nicer brightness gradient with soft edges)
+      bitshift = 1;
+    rendersize += 2;
+    offset--;
+    blurSplat(k, rendersize, xsize << bitshift, ysize << bitshift, offset);
+    xsize = xsize > 64 ? xsize - 64 : 0;
+    ysize = ysize > 64 ? ysize - 64 : 0;
+  }
+  k.rendersize = rendersize;
+  k.offset = offset;
+  return &k;
+}
+
+// collision grid is shared by all particle systems (only used during handleCollisions()) and allocated on first use
+static uint16_t *collisionGrid = nullptr;
+static uint32_t collisionGridSize = 0; // in uint16_t
+static unsigned long collisionGridLastUsed = 0;
+
+void purgeParticleBuffers() {
+  const unsigned long now = millis();
+  if (splatCache && now - splatLastUsed > PS_BUFFER_TIMEOUT) {
+    d_free(splatCache);
+    splatCache = nullptr;
+  }
+  if (collisionGrid && now - collisionGridLastUsed > PS_BUFFER_TIMEOUT) {
+    d_free(collisionGrid);
+    collisionGrid = nullptr;
+    collisionGridSize = 0;
+  }
+}
+
 // calculate pixel positions and brightness distribution and render the particle to local buffer or global buffer
 __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGB& color, const bool wrapX, const bool wrapY) {
   uint32_t size = particlesize;
@@ -687,34 +825,36 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
   pxlbrightness[3] = gamma8inv(pxlbrightness[3]);
 
   if (advPartProps && advPartProps[particleindex].size > 1) { //render particle to a bigger size
-    CRGB renderbuffer[100]; // 10x10 pixel buffer
-    memset(renderbuffer, 0, sizeof(renderbuffer)); // clear buffer
     //particle size to pixels: < 64 is 4x4, < 128 is 6x6, < 192 is 8x8, bigger is 10x10
-    //first, render the pixel to the center of the renderbuffer, then apply 2D blurring
-    fast_color_add(renderbuffer[4 + (4 * 10)], color, pxlbrightness[0]); // oCrder is: bottom left, bottom right, top right, top left
-    fast_color_add(renderbuffer[5 + (4 * 10)], color, pxlbrightness[1]);
-    fast_color_add(renderbuffer[5 + (5 * 10)], color, pxlbrightness[2]);
-    fast_color_add(renderbuffer[4 + (5 * 10)], color, pxlbrightness[3]);
-    uint32_t rendersize = 2; // initialize render size, minimum is 4x4 pixels, it is incremented int he loop below to start with 4
+    uint32_t xsize = advPartProps[particleindex].size;
+    uint32_t ysize = xsize;
+    if (advPartSize && advPartSize[particleindex].asymmetry > 0) // use advanced size control
+      getParticleXYsize(&advPartProps[particleindex], &advPartSize[particleindex], xsize, ysize);
+    const PSsplat *splat = getSplat(xsize, ysize);
+    uint32_t rendersize = 2; // initialize render size, minimum is 4x4 pixels, it is incremented in the loop below to start with 4
     uint32_t offset = 4; // offset to zero coordinate to write/read data in renderbuffer (actually needs to be 3, is decremented in the loop below)
-    uint32_t maxsize = advPartProps[particleindex].size;
-    uint32_t xsize = maxsize;
-    uint32_t ysize = maxsize;
-    if (advPartSize) { // use advanced size control
-      if (advPartSize[particleindex].asymmetry > 0)
-        getParticleXYsize(&advPartProps[particleindex], &advPartSize[particleindex], xsize, ysize);
-      maxsize = (xsize > ysize) ? xsize : ysize; // choose the bigger of the two
-    }
-    maxsize = maxsize/64 + 1; // number of blur passes depends on maxsize, four passes max
-    uint32_t bitshift = 0;
-    for (uint32_t i = 0; i < maxsize; i++) {
-      if (i == 2) //for the last two passes, use higher amount of blur (results in a nicer brightness gradient with soft edges)
-        bitshift = 1;
-      rendersize += 2;
-      offset--;
-      blur2D(renderbuffer, rendersize, rendersize, xsize << bitshift, ysize << bitshift, offset, offset, true);
-      xsize = xsize > 64 ? xsize - 64 : 0;
-      ysize = ysize > 64 ? ysize - 64 : 0;
+    CRGB renderbuffer[100]; // 10x10 pixel buffer, only used if there is no kernel for this size
+    if (splat) {
+      rendersize = splat->rendersize;
+      offset = splat->offset;
+    } else {
+      memset(renderbuffer, 0, sizeof(renderbuffer)); // clear buffer
+      //first, render the pixel to the center of the renderbuffer, then apply 2D blurring
+      fast_color_add(renderbuffer[4 + (4 * 10)], color, pxlbrightness[0]); // order is: bottom left, bottom right, top right, top left
+      fast_color_add(renderbuffer[5 + (4 * 10)], color, pxlbrightness[1]);
+      fast_color_add(renderbuffer[5 + (5 * 10)], color, pxlbrightness[2]);
+      fast_color_add(renderbuffer[4 + (5 * 10)], color, pxlbrightness[3]);
+      uint32_t passes = max(xsize, ysize) / 64 + 1; // number of blur passes depends on size, four passes max
+      uint32_t bitshift = 0;
+      for (uint32_t i = 0; i < passes; i++) {
+        if (i == 2) //for the last two passes, use higher amount of blur (results in a nicer brightness gradient with soft edges)
+          bitshift = 1;
+        rendersize += 2;
+        offset--;
+        blur2D(renderbuffer, rendersize, rendersize, xsize << bitshift, ysize << bitshift, offset, offset, true);
+        xsize = xsize > 64 ? xsize - 64 : 0;
+        ysize = ysize > 64 ? ysize - 64 : 0;
+      }
     }
 
     // calculate origin coordinates to render the particle to in the framebuffer
@@ -725,7 +865,7 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
     //note on y-axis flip: WLED has the y-axis defined from top to bottom, so y coordinates must be flipped. doing this in the buffer xfer clashes with 1D/2D combined rendering, which does not invert y
     //                     transferring the 1D buffer in inverted fashion will flip the x-axis of overlaid 2D FX, so the y-axis flip is done here so the buffer is flipped in y, giving correct results
 
-    // transfer particle renderbuffer to framebuffer
+    // weight the four sub-pixel stamps of the kernel (or take the blurred renderbuffer) and add them to framebuffer
     for (uint32_t xrb = offset; xrb < rendersize + offset; xrb++) {
       xfb = xfb_orig + xrb;
       if (xfb > (uint32_t)maxXpixel) {
@@ -751,7 +891,29 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
           else
           continue;
         }
-        fast_color_add(framebuffer[xfb + (maxYpixel - yfb) * (maxXpixel + 1)], renderbuffer[xrb + yrb * 10]);
+        if (!splat) {
+          fast_color_add(framebuffer[xfb + (maxYpixel - yfb) * (maxXpixel + 1)], renderbuffer[xrb + yrb * 10]);
+          continue;
+        }
+        const uint16_t *w = splat->w[xrb + yrb * PS_SPLAT_SIZE];
+        uint32_t scale = (pxlbrightness[0] * w[0] + pxlbrightness[1] * w[1] + pxlbrightness[2] * w[2] + pxlbrightness[3] * w[3]) / 255;
+        if (scale == 0) continue;
+        CRGB &fbpixel = framebuffer[xfb + (maxYpixel - yfb) * (maxXpixel + 1)];
+        if (scale < 255) {
+          fast_color_add(fbpixel, color, scale);
+        } else { // kernel amplifies, saturate but preserve color
+          uint32_t r = (color.r * scale) >> 8;
+          uint32_t g = (color.g * scale) >> 8;
+          uint32_t b = (color.b * scale) >> 8;
+          uint32_t max = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+          if (max > 255) {
+            uint32_t newscale = (255U << 16) / max;
+            r = (r * newscale) >> 16;
+            g = (g * newscale) >> 16;
+            b = (b * newscale) >> 16;
+          }
+          fast_color_add(fbpixel, CRGB(r, g, b));
+        }
       }
     }
     } else { // standard rendering (2x2 pixels)
@@ -792,68 +954,98 @@ __attribute__((optimize("O2"))) void ParticleSystem2D::renderParticle(const uint
   }
 }
 
+// collision grid holds cell start indices (+1 for end of last cell) and particle indices sorted by cell
+// cell count is limited by the number of particles, larger cells are still correct
+static inline uint32_t maxCollisionCells(uint32_t numparticles) { return max((uint32_t)64, numparticles >> 1); }
+
 // detect collisions in an array of particles and handle them
-// uses binning by dividing the frame into slices in x direction which is efficient if using gravity in y direction (but less efficient for FX that use forces in x direction)
-// for code simplicity, no y slicing is done, making very tall matrix configurations less efficient
-// note: also tested adding y slicing, it gives diminishing returns, some FX even get slower. FX not using gravity would benefit with a 10% FPS improvement
+// uses a uniform grid (spatial hash) built by counting sort: particles are sorted into square cells that are at least as
+// large as the collision distance so only particles in the same or in adjacent cells need to be checked
+// each cell is checked against itself and four of its neighbours (right, bottom left, bottom, bottom right) so every pair is tested once
 void ParticleSystem2D::handleCollisions() {
-  uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
-  collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
-  // note: partices are binned in x-axis, assumption is that no more than half of the particles are in the same bin
-  // if they are, collisionStartIdx is increased so each particle collides at least every second frame (which still gives decent collisions)
-  constexpr int BIN_WIDTH = 6 * PS_P_RADIUS; // width of a bin in sub-pixels
-  int32_t overlap = particleHardRadius << 1; // overlap bins to include edge particles to neighbouring bins
-  if (advPartProps) //may be using individual particle size
-    overlap += 512; // add 2 * max radius (approximately)
-  uint32_t maxBinParticles = max((uint32_t)50, (usedParticles + 1) / 2); // assume no more than half of the particles are in the same bin, do not bin small amounts of particles
-  uint32_t numBins = (maxX + (BIN_WIDTH - 1)) / BIN_WIDTH; // number of bins in x direction
-  uint16_t binIndices[maxBinParticles]; // creat array on stack for indices, 2kB max for 1024 particles (ESP32_MAXPARTICLES/2)
-  uint32_t binParticleCount; // number of particles in the current bin
-  uint16_t nextFrameStartIdx = hw_random16(usedParticles); // index of the first particle in the next frame (set to fixed value if bin overflow)
-  uint32_t pidx = collisionStartIdx; //start index in case a bin is full, process remaining particles next frame
-
-  // fill the binIndices array for this bin
-  for (uint32_t bin = 0; bin < numBins; bin++) {
-    binParticleCount = 0; // reset for this bin
-    int32_t binStart = bin * BIN_WIDTH - overlap; // note: first bin will extend to negative, but that is ok as out of bounds particles are ignored
-    int32_t binEnd = binStart + BIN_WIDTH + overlap; // note: last bin can be out of bounds, see above;
-
-    // fill the binIndices array for this bin
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (particles[pidx].ttl > 0) { // is alive
-        if (particles[pidx].x >= binStart && particles[pidx].x <= binEnd) { // >= and <= to include particles on the edge of the bin (overlap to ensure boarder particles collide with adjacent bins)
-          if(particleFlags[pidx].outofbounds == 0 && particleFlags[pidx].collide) { // particle is in frame and does collide note: checking flags is quite slow and usually these are set, so faster to check here
-            if (binParticleCount >= maxBinParticles) { // bin is full, more particles in this bin so do the rest next frame
-              nextFrameStartIdx = pidx; // bin overflow can only happen once as bin size is at least half of the particles (or half +1)
-              break;
-            }
-            binIndices[binParticleCount++] = pidx;
-          }
-        }
-      }
-      pidx++;
-      if (pidx >= usedParticles) pidx = 0; // wrap around
+  uint32_t collDist = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
+  const uint32_t baseCollDist = collDist;
+  uint32_t collDistSq = collDist * collDist; // square it for faster comparison (square is one operation)
+  if (advPartProps) collDist += 255; // may be using individual particle size, add maximum individual size
+  uint32_t cellSize = collDist; // particles are binned by position with lookahead, same as used for the distance check
+  uint32_t gridX = maxX / cellSize + 1;
+  uint32_t gridY = maxY / cellSize + 1;
+  const uint32_t maxCells = maxCollisionCells(usedParticles); // limit grid size for large matrices
+  while (gridX * gridY > maxCells) {
+    cellSize <<= 1;
+    gridX = maxX / cellSize + 1;
+    gridY = maxY / cellSize + 1;
+  }
+  const uint32_t numCells = gridX * gridY;
+
+  // grid memory (grown as needed, released by purgeParticleBuffers()): cell start indices (+1 for end of last cell) followed by particle indices sorted by cell
+  const uint32_t gridSize = maxCells + 1 + usedParticles;
+  if (gridSize > collisionGridSize) {
+    uint16_t *grid = static_cast<uint16_t*>(collisionGrid ? d_realloc(collisionGrid, gridSize * sizeof(uint16_t)) : d_malloc(gridSize * sizeof(uint16_t)));
+    if (!grid) return; // no memory, skip collisions
+    collisionGrid = grid;
+    collisionGridSize = gridSize;
+  }
+  collisionGridLastUsed = millis();
+  uint16_t *cellStart = collisionGrid;
+  uint16_t *sorted = cellStart + numCells + 1;
+  memset(cellStart, 0, (numCells + 1) * sizeof(uint16_t));
+
+  // cell of a colliding particle (position with lookahead), numCells if particle does not collide
+  auto particleCell = [&](uint32_t i) -> uint32_t {
+    if (particles[i].ttl == 0 || particleFlags[i].outofbounds || !particleFlags[i].collide) return numCells;
+    const int32_t x = constrain((int32_t)particles[i].x + particles[i].vx, 0, maxX);
+    const int32_t y = constrain((int32_t)particles[i].y + particles[i].vy, 0, maxY);
+    return (y / cellSize) * gridX + (x / cellSize);
+  };
+  // count particles in each cell
+  for (uint32_t i = 0; i < activeParticles; i++) {
+    const uint32_t cell = particleCell(i);
+    if (cell < numCells) cellStart[cell]++;
+  }
+  // prefix sum: cellStart[c] is end of cell c, decremented to its start while sorting
+  for (uint32_t c = 1; c <= numCells; c++) cellStart[c] += cellStart[c - 1];
+  // start at random index so particle order within a cell (which particle gets pushed) changes every frame
+  uint32_t pidx = hw_random16(activeParticles);
+  for (uint32_t i = 0; i < activeParticles; i++) {
+    const uint32_t cell = particleCell(pidx);
+    if (cell < numCells) sorted[--cellStart[cell]] = pidx;
+    if (pidx == 0) pidx = activeParticles;
+    pidx--;
+  }
+
+  auto collidePair = [&](uint32_t idx_i, uint32_t idx_j) {
+    if (advPartProps) { //may be using individual particle size
+      collDistSq = baseCollDist + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
+      collDistSq = collDistSq * collDistSq; // square it for faster comparison
     }
-
-    for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles in this bin and see if any of those are in close proximity and if they are, make them collide
-      uint32_t idx_i = binIndices[i];
-      for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (advPartProps) { //may be using individual particle size
-          setParticleSize(particlesize); // updates base particleHardRadius
-          collDistSq = (particleHardRadius << 1) + (((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) >> 1); // collision distance note: not 100% clear why the >> 1 is needed, but it is.
-          collDistSq = collDistSq * collDistSq; // square it for faster comparison
-        }
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
-        if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
-          int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
-          if (dy * dy < collDistSq) // particles are close
-            collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
+    int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
+    if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
+      int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
+      if (dy * dy < collDistSq) // particles are close
+        collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq);
+    }
+  };
+
+  constexpr int8_t neighbours[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+  for (uint32_t cy = 0; cy < gridY; cy++) {
+    for (uint32_t cx = 0; cx < gridX; cx++) {
+      const uint32_t cell = cy * gridX + cx;
+      const uint32_t start = cellStart[cell];
+      const uint32_t end = cellStart[cell + 1];
+      for (uint32_t i = start; i < end; i++) {
+        const uint32_t idx_i = sorted[i];
+        for (uint32_t j = i + 1; j < end; j++) collidePair(idx_i, sorted[j]); // same cell
+        for (const auto &n : neighbours) {
+          const int32_t nx = cx + n[0];
+          const int32_t ny = cy + n[1];
+          if (nx < 0 || nx >= (int32_t)gridX || ny >= (int32_t)gridY) continue;
+          const uint32_t ncell = ny * gridX + nx;
+          for (uint32_t j = cellStart[ncell]; j < cellStart[ncell + 1]; j++) collidePair(idx_i, sorted[j]);
         }
       }
     }
   }
-  collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
 }
 
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
@@ -1013,8 +1205,6 @@ void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
 
 // blur a matrix in x and y direction, blur can be asymmetric in x and y
 // for speed, 1D array and 32bit variables are used, make sure to limit them to 8bit (0-255) or result is undefined
-// to blur a subset of the buffer, change the xsize/ysize and set xstart/ystart to the desired starting coordinates (default start is 0/0)
-// subset blurring only works on 10x10 buffer (single particle rendering), if other sizes are needed, buffer width must be passed as parameter
 void blur2D(CRGB *colorbuffer, uint32_t xsize, uint32_t ysize, uint32_t xblur, uint32_t yblur, uint32_t xstart, uint32_t ystart, bool isparticle) {
   CRGB seeppart, carryover;
   uint32_t seep = xblur >> 1;
@@ -118,6 +118,15 @@ typedef struct { // 8 bytes
 } PSsizeControl;
 
 
+// precomputed render kernel for large particles (see ParticleSystem2D::getSplat())
+#define PS_SPLAT_SIZE 10 // kernel is 10x10 pixels, particle impulses are at 4/4, 5/4, 5/5 and 4/5
+typedef struct {
+  uint16_t w[PS_SPLAT_SIZE * PS_SPLAT_SIZE][4]; // weight of bottom left, bottom right, top right and top left impulse, 255 is unity
+  uint8_t xsize, ysize; // particle size the kernel is made for
+  uint8_t offset, rendersize; // area of kernel that is used, rendersize is 0 if kernel is unused
+  unsigned long lastUsed; // millis()
+} PSsplat;
+
 //struct for a particle source (20 bytes)
 typedef struct {
   uint16_t minLife; // minimum ttl of emittet particles
@@ -183,6 +192,7 @@ public:
   int32_t maxXpixel, maxYpixel; // last physical pixel that can be drawn to (FX can read this to read segment size if required), equal to width-1 / height-1
   uint32_t numSources; // number of sources
   uint32_t usedParticles; // number of particles used in animation, is relative to 'numParticles'
+  uint32_t activeParticles; // all particles at or above this index are dead (maintained by update() and emit functions)
   //note: some variables are 32bit for speed and code size at the cost of ram
 
 private:
@@ -190,15 +200,17 @@ private:
   void render();
   [[gnu::hot]] void renderParticle(const uint32_t particleindex, const uint8_t brightness, const CRGB& color, const bool wrapX, const bool wrapY);
   //paricle physics applied by system if flags are set
-  void applyGravity(); // applies gravity to all particles
   void handleCollisions();
   [[gnu::hot]] void collideParticles(PSparticle &particle1, PSparticle &particle2, const int32_t dx, const int32_t dy, const uint32_t collDistSq);
   void fireParticleupdate();
   //utility functions
+  void compactParticles(); // move live particles into slots of dead ones (keeps all live particles below activeParticles)
+  void updateActiveParticles();
   void updatePSpointers(const bool isadvanced, const bool sizecontrol); // update the data pointers to current segment data space
   bool updateSize(PSadvancedParticle *advprops, PSsizeControl *advsize); // advanced size control
   void getParticleXYsize(PSadvancedParticle *advprops, PSsizeControl *advsize, uint32_t &xsize, uint32_t &ysize);
-  [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
+  static const PSsplat *getSplat(uint32_t xsize, uint32_t ysize); // get (or build) render kernel for large particles
+  [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition, const uint32_t hardRadius); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
   CRGB *framebuffer; // local frame buffer for rendering
   PSsettings2D particlesettings; // settings used when updating particles (can also used by FX to move sources), do not edit properties directly, use functions above
@@ -208,7 +220,6 @@ private:
   uint32_t wallHardness;
   uint32_t wallRoughness; // randomizes wall collisions  
   uint32_t particleHardRadius; // hard surface radius of a particle, used for collision detection (32bit for speed)
-  uint16_t collisionStartIdx; // particle array start index for collision detection
   uint8_t fireIntesity = 0; // fire intensity, used for fire mode (flash use optimization, better than passing an argument to render function)
   uint8_t forcecounter; // counter for globally applied forces
   uint8_t gforcecounter; // counter for global gravity
@@ -225,6 +236,7 @@ bool initParticleSystem2D(ParticleSystem2D *&PartSys, const uint32_t requestedso
 uint32_t calculateNumberOfParticles2D(const uint32_t pixels, const bool advanced, const bool sizecontrol);
 uint32_t calculateNumberOfSources2D(const uint32_t pixels, const uint32_t requestedsources);
 bool allocateParticleSystemMemory2D(const uint32_t numparticles, const uint32_t numsources, const bool advanced, const bool sizecontrol, const uint32_t additionalbytes);
+void purgeParticleBuffers(); // release render kernels and collision grid if no particle system used them for a while
 #endif // WLED_DISABLE_PARTICLESYSTEM2D
 
 ////////////////////////
@@ -24,12 +24,21 @@
 #include "bus_manager.h"
 #include "bus_wrapper.h"
 #include <bits/unique_ptr.h>
+#include <algorithm>
 
 extern bool cctICused;
 extern bool useParallelI2S;
 
 //colors.cpp
-uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb);
+void colorKtoRGB(uint16_t kelvin, byte* rgb);
+#ifdef WLED_ENABLE_DITHERING
+const uint16_t *gamma16Table();
+// only the top fractional bits are dithered: a 2^WLED_DITHER_BITS frame cycle keeps the flicker frequency
+// high enough not to be visible near black, lower bits are rounded
+#ifndef WLED_DITHER_BITS
+  #define WLED_DITHER_BITS 3
+#endif
+#endif
 
 //udp.cpp
 uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const byte *buffer, uint8_t bri=255, bool isRGBW=false);
@@ -106,9 +115,7 @@ void Bus::calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw) {
   cw = (w * cw) / 255;
 }
 
-uint32_t Bus::autoWhiteCalc(uint32_t c) const {
-  unsigned aWM = _autoWhiteMode;
-  if (_gAWM < AW_GLOBAL_DISABLED) aWM = _gAWM;
+uint32_t Bus::autoWhiteCalc(uint32_t c, unsigned aWM) {
   if (aWM == RGBW_MODE_MANUAL_ONLY) return c;
   unsigned w = W(c);
   //ignore auto-white calculation if w>0 and mode DUAL (DUAL behaves as BRIGHTER if w==0)
@@ -122,13 +129,54 @@ uint32_t Bus::autoWhiteCalc(uint32_t c) const {
   return RGBW32(r, g, b, w);
 }
 
+// finishes hash of colors (and brightness, white balance) painted in this frame, needs to be called once per frame (BusManager::show())
+void Bus::closeFrame() {
+  _paintedHash = (_frameHash ^ ((uint32_t)_bri << 16) ^ (uint16_t)_cct) * BUS_HASH_PRIME;
+  _frameHash   = BUS_HASH_SEED;
+}
+
+// returns true if bus needs to be transmitted: colors changed since last transmission or bus requires constant
+// refresh (unless only pending changes are requested), and bus max FPS allows it (changes are kept pending otherwise)
+// caller calls markShown() once bus is shown
+bool Bus::isShowDue(unsigned long now, bool force, bool pendingOnly) {
+  if (force) return true;
+  if (_maxFps && now - _lastShow < 1000U / _maxFps) return false;
+  if (isShowPending()) return true;
+  return !pendingOnly && (_needsRefresh || mustRefresh() || isDithering() || (isVirtual() && !isLoopback(_type) && now - _lastShow >= WLED_BUS_KEEPALIVE));
+}
+
+// LUT is rebuilt only when _cct changes (slow colorKtoRGB() and per channel scaling are not done for every pixel)
+const uint8_t *Bus::whiteBalanceLUT() {
+  if (_cct < 1900) return nullptr;
+  if (_wbKelvin == _cct) return _wbLUT;
+  if (!_wbLUT) _wbLUT = static_cast<uint8_t*>(d_malloc(3 * 256));
+  if (!_wbLUT) return nullptr;
+  byte correctionRGB[4];
+  colorKtoRGB(_cct, correctionRGB);
+  for (unsigned ch = 0; ch < 3; ch++)
+    for (unsigned i = 0; i < 256; i++) _wbLUT[ch*256 + i] = (correctionRGB[ch] * i) / 255;
+  _wbKelvin = _cct;
+  return _wbLUT;
+}
+
 
 BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed, (bc.refreshReq || bc.type == TYPE_TM1814))
 , _skip(bc.skipAmount) //sacrificial pixels
 , _colorOrder(bc.colorOrder)
 , _milliAmpsPerLed(bc.milliAmpsPerLed)
+, _ablBri(255)
 , _milliAmpsMax(bc.milliAmpsMax)
+, _milliAmpsTotal(0)
+, _milliAmpsFull(0)
+, _powerSum(0)
+, _powerModel(bc.powerModel <= POWER_MODEL_RGBW_FULL ? bc.powerModel : POWER_MODEL_LINEAR)
+, _psu(bc.psu <= WLED_MAX_PSU_GROUPS ? bc.psu : 0)
+#ifdef WLED_ENABLE_DITHERING
+, _dither(bc.type != TYPE_WS2812_1CH_X3 && !hasCCT(bc.type)) // types with per pixel channel mapping use NPB luminance
+, _ditherFrame(0)
+, _ditherThr(0)
+#endif
 {
   DEBUGBUS_PRINTLN(F("Bus: Creating digital bus."));
   if (!isDigital(bc.type) || !bc.count) { DEBUGBUS_PRINTLN(F("Not digial or empty bus!")); return; }
@@ -173,79 +221,97 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 //I am NOT to be held liable for burned down garages or houses!
 
 // To disable brightness limiter we either set output max current to 0 or single LED current to 0
-uint8_t BusDigital::estimateCurrentAndLimitBri() const {
-  bool useWackyWS2815PowerModel = false;
-  byte actualMilliampsPerLed = _milliAmpsPerLed;
-
-  if (_milliAmpsMax < MA_FOR_ESP/BusManager::getNumBusses() || actualMilliampsPerLed == 0) { //0 mA per LED and too low numbers turn off calculation
-    return _bri;
-  }
-
-  if (_milliAmpsPerLed == 255) {
-    useWackyWS2815PowerModel = true;
-    actualMilliampsPerLed = 12; // from testing an actual strip
-  }
+bool BusDigital::hasCurrentLimit() const {
+  return _valid && _milliAmpsPerLed > 0 && _milliAmpsMax >= MA_FOR_ESP/BusManager::getNumBusses(); //0 mA per LED and too low numbers turn off calculation
+}
 
-  unsigned powerBudget = (_milliAmpsMax - MA_FOR_ESP/BusManager::getNumBusses()); //80/120mA for ESP power
-  if (powerBudget > getLength()) { //each LED uses about 1mA in standby, exclude that from power budget
-    powerBudget -= getLength();
-  } else {
-    powerBudget = 0;
-  }
+// sum of channel values of a LED (white is ignored on WS2815 & similar, brightest RGB channel drives all)
+static inline uint32_t ledPower(uint32_t c, bool maxRGB) {
+  return maxRGB ? std::max(std::max(R(c), G(c)), B(c)) * 3 : R(c) + G(c) + B(c) + W(c);
+}
 
+// sums up the usage of each LED (c is color being painted at full brightness)
+// setPixels() collects the same inline, this is only used for types painted pixel by pixel
+void IRAM_ATTR BusDigital::addPowerUsage(const uint32_t *c, unsigned n) {
+  const bool maxRGB = useMaxRGBPowerModel();
+  const unsigned aWM = hasWhite() ? activeAutoWhiteMode() : RGBW_MODE_MANUAL_ONLY;
   uint32_t busPowerSum = 0;
-  for (unsigned i = 0; i < getLength(); i++) {  //sum up the usage of each LED
-    uint32_t c = getPixelColor(i); // always returns original or restored color without brightness scaling
-    byte r = R(c), g = G(c), b = B(c), w = W(c);
+  for (unsigned i = 0; i < n; i++) busPowerSum += ledPower(autoWhiteCalc(c[i], aWM), maxRGB);
+  _powerSum += busPowerSum;
+}
 
-    if (useWackyWS2815PowerModel) { //ignore white component on WS2815 power calculation
-      busPowerSum += (max(max(r,g),b)) * 3;
-    } else {
-      busPowerSum += (r + g + b + w);
-    }
+// converts channel values collected while painting (previous frame) into current (mA) at full brightness
+uint32_t BusDigital::estimateCurrent() {
+  uint32_t busPowerSum = _powerSum;
+  _powerSum = 0;
+  _milliAmpsFull = 0;
+  if (!hasPowerModel()) return 0;
+
+  unsigned actualMilliampsPerLed = _milliAmpsPerLed;
+  if (_milliAmpsPerLed == 255) {
+    actualMilliampsPerLed = 12; // from testing an actual strip
   }
 
-  if (hasWhite()) { //RGBW led total output with white LEDs enabled is still 50mA, so each channel uses less
+  if (hasWhite() && _powerModel == POWER_MODEL_LINEAR && _milliAmpsPerLed != 255) {
+    //RGBW led total output with white LEDs enabled is still 50mA, so each channel uses less
     busPowerSum *= 3;
     busPowerSum >>= 2; //same as /= 4
   }
 
   // powerSum has all the values of channels summed (max would be getLength()*765 as white is excluded) so convert to milliAmps
-  BusDigital::_milliAmpsTotal = (busPowerSum * actualMilliampsPerLed * _bri) / (765*255);
+  _milliAmpsFull = (busPowerSum * actualMilliampsPerLed) / 765;
+  return _milliAmpsFull;
+}
 
-  uint8_t newBri = _bri;
-  if (BusDigital::_milliAmpsTotal > powerBudget) {
-    //scale brightness down to stay in current limit
-    unsigned scaleB = powerBudget * 255 / BusDigital::_milliAmpsTotal;
-    newBri = (_bri * scaleB) / 256 + 1;
-    BusDigital::_milliAmpsTotal = powerBudget;
-    //_milliAmpsTotal = (busPowerSum * actualMilliampsPerLed * newBri) / (765*255);
+// called before pixels are painted with brightness allowed by global or PSU group ABL (BusManager::applyCurrentLimits())
+// NeoPixelBus applies brightness (luminance) while setting pixels
+void BusDigital::applyCurrentLimit(uint8_t bri) {
+  _milliAmpsTotal = 0;
+  if (!_valid) return;
+  const uint8_t oldBri = _ablBri;
+  if (bri > _bri) bri = _bri;
+  uint32_t milliAmps = (_milliAmpsFull * bri) / 255;
+  if (hasCurrentLimit()) {
+    unsigned powerBudget = (_milliAmpsMax - MA_FOR_ESP/BusManager::getNumBusses()); //80/120mA for ESP power
+    if (powerBudget > getLength()) { //each LED uses about 1mA in standby, exclude that from power budget
+      powerBudget -= getLength();
+    } else {
+      powerBudget = 0;
+    }
+    if (milliAmps > powerBudget) {
+      //scale brightness down to stay in current limit
+      unsigned scaleB = powerBudget * 255 / milliAmps;
+      bri = (bri * scaleB) / 256 + 1;
+      milliAmps = powerBudget;
+    }
   }
-  return newBri;
+  _milliAmpsTotal = std::min(milliAmps, (uint32_t)UINT16_MAX);
+  _ablBri = bri;
+  #ifdef WLED_ENABLE_DITHERING
+  if (_dither) return; // _ablBri is applied while painting
+  #endif
+  // limit brightness to stay within current limits (or restore it if bus was not shown after last limiting, see BusManager::show())
+  if (_ablBri < _bri || oldBri < _bri) PolyBus::setBrightness(_busPtr, _iType, _ablBri);
 }
 
 void BusDigital::show() {
-  BusDigital::_milliAmpsTotal = 0;
   if (!_valid) return;
-
-  uint8_t cctWW = 0, cctCW = 0;
-  unsigned newBri = estimateCurrentAndLimitBri();  // will fill _milliAmpsTotal (TODO: could use PolyBus::CalcTotalMilliAmpere())
-  if (newBri < _bri) PolyBus::setBrightness(_busPtr, _iType, newBri); // limit brightness to stay within current limits
-    if (newBri < _bri) {
-      unsigned hwLen = _len;
-      if (_type == TYPE_WS2812_1CH_X3) hwLen = NUM_ICS_WS2812_1CH_3X(_len); // only needs a third of "RGB" LEDs for NeoPixelBus
-      for (unsigned i = 0; i < hwLen; i++) {
-        // use 0 as color order, actual order does not matter here as we just update the channel values as-is
-        uint32_t c = restoreColorLossy(PolyBus::getPixelColor(_busPtr, _iType, i, 0), _bri);
-        if (hasCCT()) Bus::calculateCCT(c, cctWW, cctCW); // this will unfortunately corrupt (segment) CCT data on every bus
-        PolyBus::setPixelColor(_busPtr, _iType, i, c, 0, (cctCW<<8) | cctWW); // repaint all pixels with new brightness
-      }
-    }
   PolyBus::show(_busPtr, _iType, false); // faster if buffer consistency is not important
+  #ifdef WLED_ENABLE_DITHERING
+  if (_dither) {
+    // next threshold: bit reversed counter spreads thresholds evenly over any run of consecutive frames
+    uint8_t f = ++_ditherFrame;
+    f = (f & 0xF0) >> 4 | (f & 0x0F) << 4;
+    f = (f & 0xCC) >> 2 | (f & 0x33) << 2;
+    f = (f & 0xAA) >> 1 | (f & 0x55) << 1;
+    _ditherThr = f >> (8 - WLED_DITHER_BITS);
+    return;
+  }
+  #endif
   // restore bus brightness to its original value
   // this is done right after show, so this is only OK if LED updates are completed before show() returns
   // or async show has a separate buffer (ESP32 RMT and I2S are ok)
-  if (newBri < _bri) PolyBus::setBrightness(_busPtr, _iType, _bri);
+  if (_ablBri < _bri) PolyBus::setBrightness(_busPtr, _iType, _bri);
 }
 
 bool BusDigital::canShow() const {
@@ -256,9 +322,35 @@ bool BusDigital::canShow() const {
 void BusDigital::setBrightness(uint8_t b) {
   if (_bri == b) return;
   Bus::setBrightness(b);
+  _ablBri = b;
+  #ifdef WLED_ENABLE_DITHERING
+  if (_dither) return; // NPB luminance stays at 255
+  #endif
   PolyBus::setBrightness(_busPtr, _iType, b);
 }
 
+#ifdef WLED_ENABLE_DITHERING
+// applies gamma (if gamma table is given) and brightness to 8 bit color c with 16 bit precision, result is
+// reduced to 8 bits by temporal dithering: threshold changes each frame and is offset for each pixel so
+// adjacent LEDs do not flicker in sync; averaged over frames output matches the 16 bit value
+// white balance (if active) is applied here as well (per channel gains taken from LUT) so it stays after gamma
+uint32_t IRAM_ATTR BusDigital::ditherColor(uint32_t c, const uint16_t *gamma, const uint8_t *wbLUT, unsigned pix) const {
+  constexpr unsigned mask = (1U << WLED_DITHER_BITS) - 1;
+  const unsigned thr = (((_ditherThr + pix * 3) & mask) << (8 - WLED_DITHER_BITS)) + (0x80 >> WLED_DITHER_BITS); // + half step rounds lower bits
+  uint32_t out = 0;
+  for (unsigned s = 0; s < 32; s += 8) {
+    const unsigned v = (c >> s) & 0xFF;
+    unsigned scale = _ablBri;
+    if (wbLUT && s < 24) scale = (scale * wbLUT[(2 - s/8) * 256 + 255]) / 255; // B, G, R gains
+    uint32_t l = gamma ? gamma[v] : v * 257U;   // 16 bit
+    l = (l * scale * 257U) >> 16;               // brightness (/255)
+    const unsigned o = (l + thr) >> 8;
+    out |= (o > 255 ? 255 : o) << s;
+  }
+  return out;
+}
+#endif
+
 //If LEDs are skipped, it is possible to use the first as a status LED.
 //TODO only show if no new show due in the next 50ms
 void BusDigital::setStatusPixel(uint32_t c) {
@@ -271,14 +363,18 @@ void BusDigital::setStatusPixel(uint32_t c) {
 void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   if (!_valid) return;
   if (hasWhite()) c = autoWhiteCalc(c);
-  if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
+  #ifdef WLED_ENABLE_DITHERING
+  if (_dither) c = ditherColor(c, nullptr, whiteBalanceLUT(), pix);
+  else
+  #endif
+  c = colorBalance(c); //color correction from CCT
   if (_reversed) pix = _len - pix -1;
   pix += _skip;
   unsigned co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
   if (_type == TYPE_WS2812_1CH_X3) { // map to correct IC, each controls 3 LEDs
     unsigned pOld = pix;
     pix = IC_INDEX_WS2812_1CH_3X(pix);
-    uint32_t cOld = restoreColorLossy(PolyBus::getPixelColor(_busPtr, _iType, pix, co),_bri);
+    uint32_t cOld = restoreColorLossy(PolyBus::getPixelColor(_busPtr, _iType, pix, co),_ablBri);
     switch (pOld % 3) { // change only the single channel (TODO: this can cause loss because of get/set)
       case 0: c = RGBW32(R(cOld), W(c)   , B(cOld), 0); break;
       case 1: c = RGBW32(W(c)   , G(cOld), B(cOld), 0); break;
@@ -295,13 +391,50 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   PolyBus::setPixelColor(_busPtr, _iType, pix, c, co, wwcw);
 }
 
+// bulk variant of setPixelColor(), per bus invariants are evaluated once
+void IRAM_ATTR BusDigital::setPixels(unsigned pix, const uint32_t *c, unsigned n, const uint32_t *linear) {
+  if (!_valid) return;
+  const bool measure = hasPowerModel(); // ABL: power of painted colors limits brightness of next frame
+  if (_type == TYPE_WS2812_1CH_X3 || hasCCT()) { // per pixel channel mapping
+    if (measure) addPowerUsage(c, n);
+    Bus::setPixels(pix, c, n);
+    return;
+  }
+  const bool maxRGB = useMaxRGBPowerModel();
+  uint32_t powerSum = 0;
+  const unsigned aWM = hasWhite() ? activeAutoWhiteMode() : RGBW_MODE_MANUAL_ONLY;
+  const uint8_t *wbLUT = whiteBalanceLUT(); //color correction from CCT
+  #ifdef WLED_ENABLE_DITHERING
+  // with colors before gamma correction at hand gamma is applied in 16 bit (auto white is then calculated before gamma)
+  const uint16_t *gamma = _dither && linear ? gamma16Table() : nullptr;
+  if (!gamma) linear = nullptr; // not dithering or gamma correction is disabled (both are the same)
+  #endif
+  for (unsigned i = 0; i < n; i++, pix++) {
+    #ifdef WLED_ENABLE_DITHERING
+    uint32_t col = linear ? linear[i] : c[i];
+    if (aWM != RGBW_MODE_MANUAL_ONLY) col = autoWhiteCalc(col, aWM);
+    if (measure) powerSum += ledPower(linear ? autoWhiteCalc(c[i], aWM) : col, maxRGB); // power of gamma corrected color
+    if (_dither) col = ditherColor(col, gamma, wbLUT, pix);
+    else
+    #else
+    uint32_t col = c[i];
+    if (aWM != RGBW_MODE_MANUAL_ONLY) col = autoWhiteCalc(col, aWM);
+    if (measure) powerSum += ledPower(col, maxRGB);
+    #endif
+    if (wbLUT) col = colorBalance(col, wbLUT);
+    unsigned p = (_reversed ? _len - pix - 1 : pix) + _skip;
+    PolyBus::setPixelColor(_busPtr, _iType, p, col, _colorOrderMap.getPixelColorOrder(p+_start, _colorOrder), 0);
+  }
+  _powerSum += powerSum;
+}
+
 // returns original color if global buffering is enabled, else returns lossly restored color from bus
 uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
   if (_reversed) pix = _len - pix -1;
   pix += _skip;
   const unsigned co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
-  uint32_t c = restoreColorLossy(PolyBus::getPixelColor(_busPtr, _iType, (_type==TYPE_WS2812_1CH_X3) ? IC_INDEX_WS2812_1CH_3X(pix) : pix, co),_bri);
+  uint32_t c = restoreColorLossy(PolyBus::getPixelColor(_busPtr, _iType, (_type==TYPE_WS2812_1CH_X3) ? IC_INDEX_WS2812_1CH_3X(pix) : pix, co),_ablBri);
   if (_type == TYPE_WS2812_1CH_X3) { // map to correct IC, each controls 3 LEDs
     unsigned r = R(c);
     unsigned g = _reversed ? B(c) : G(c); // should G and B be switched if _reversed?
@@ -325,6 +458,18 @@ size_t BusDigital::getPins(uint8_t* pinArray) const {
   return numPins;
 }
 
+// estimated time on the wire for one frame: data bits at protocol bit rate plus latch/reset
+unsigned BusDigital::wireTime(uint8_t type, unsigned ics, uint16_t kHz) {
+  unsigned bytes = ics * (type == TYPE_WS2812_1CH_X3 ? 3 : getNumberOfChannels(type)) * (is16bit(type) ? 2 : 1);
+  if (is2Pin(type)) return (bytes * 8 + 64) * 1000U / (kHz ? kHz : 2000U); // start & end frames (approx.)
+  return bytes * 8 * (type == TYPE_WS2811_400KHZ ? 2500U : 1250U) / 1000U + 300; // 800kbps (1.25us per bit) + reset
+}
+
+unsigned BusDigital::getWireTime() const {
+  if (!_valid) return 0;
+  return wireTime(_type, (_type == TYPE_WS2812_1CH_X3 ? NUM_ICS_WS2812_1CH_3X(_len) : _len) + _skip, _frequencykHz);
+}
+
 size_t BusDigital::getBusSize() const {
   return sizeof(BusDigital) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) /*+ (_data ? _len * getNumberOfChannels() : 0)*/ : 0);
 }
@@ -454,8 +599,8 @@ BusPwm::BusPwm(const BusConfig &bc)
 void BusPwm::setPixelColor(unsigned pix, uint32_t c) {
   if (pix != 0 || !_valid) return; //only react to first pixel
   if (_type != TYPE_ANALOG_3CH) c = autoWhiteCalc(c);
-  if (Bus::_cct >= 1900 && (_type == TYPE_ANALOG_3CH || _type == TYPE_ANALOG_4CH)) {
-    c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
+  if (_type == TYPE_ANALOG_3CH || _type == TYPE_ANALOG_4CH) {
+    c = colorBalance(c); //color correction from CCT
   }
   uint8_t r = R(c);
   uint8_t g = G(c);
@@ -696,7 +841,7 @@ BusNetwork::BusNetwork(const BusConfig &bc)
 void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
   if (!_valid || pix >= _len) return;
   if (_hasWhite) c = autoWhiteCalc(c);
-  if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
+  c = colorBalance(c); //color correction from CCT
   unsigned offset = pix * _UDPchannels;
   _data[offset]   = R(c);
   _data[offset+1] = G(c);
@@ -746,9 +891,88 @@ void BusNetwork::cleanup() {
 }
 
 
+#ifdef WLED_ENABLE_LOOPBACK_BUS
+BusLoopback::BusLoopback(const BusConfig &bc)
+: Bus(bc.type, bc.start, bc.autoWhite, bc.count, false, bc.refreshReq)
+, _depth(bc.pins[0] > 0 && bc.pins[0] < 255 ? bc.pins[0] : WLED_LOOPBACK_FRAMES)
+, _shown(0)
+, _stamps(nullptr)
+{
+  _hasRgb = true;
+  _hasWhite = hasWhite(bc.type);
+  _hasCCT = false;
+  _data = static_cast<uint32_t*>(d_calloc(_len * (_depth + 1U), sizeof(uint32_t)));
+  if (_data) _stamps = static_cast<unsigned long*>(d_calloc(_depth, sizeof(unsigned long)));
+  _valid = (_data != nullptr && _stamps != nullptr);
+  DEBUGBUS_PRINTF_P(PSTR("%successfully inited loopback bus with type %u and %u frames\n"), _valid?"S":"Uns", bc.type, _depth);
+}
+
+void BusLoopback::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid || pix >= _len) return;
+  if (_hasWhite) c = autoWhiteCalc(c);
+  else           c &= 0x00FFFFFF;
+  _data[pix] = colorBalance(c); //color correction from CCT
+}
+
+uint32_t BusLoopback::getPixelColor(unsigned pix) const {
+  if (!_valid || pix >= _len) return 0;
+  return _data[pix];
+}
+
+void BusLoopback::show() {
+  if (!_valid) return;
+  const unsigned slot = _shown % _depth;
+  uint32_t *frame = _data + _len * (slot + 1);
+  const uint32_t scale = _bri + 1; // same as color_fade()
+  for (unsigned i = 0; i < _len; i++) {
+    const uint32_t c = _data[i];
+    frame[i] = (((c & 0x00FF00FF) * scale) >> 8 & 0x00FF00FF) | (((c >> 8) & 0x00FF00FF) * scale & 0xFF00FF00);
+  }
+  _stamps[slot] = micros();
+  _shown++;
+}
+
+const uint32_t *BusLoopback::getFrame(unsigned back, unsigned long *timestamp) const {
+  if (!_valid || back >= getFramesAvailable()) return nullptr;
+  const unsigned slot = (_shown - 1 - back) % _depth;
+  if (timestamp) *timestamp = _stamps[slot];
+  return _data + _len * (slot + 1);
+}
+
+size_t BusLoopback::getPins(uint8_t* pinArray) const {
+  if (pinArray) pinArray[0] = _depth;
+  return 1;
+}
+
+std::vector<LEDType> BusLoopback::getLEDTypes() {
+  return {
+    {TYPE_LOOPBACK_RGB,  "V", PSTR("Loopback RGB (virtual)")},
+    {TYPE_LOOPBACK_RGBW, "V", PSTR("Loopback RGBW (virtual)")},
+  };
+}
+
+void BusLoopback::cleanup() {
+  DEBUGBUS_PRINTLN(F("Loopback Cleanup."));
+  d_free(_stamps);
+  d_free(_data);
+  _stamps = nullptr;
+  _data = nullptr;
+  _type = I_NONE;
+  _valid = false;
+}
+#endif
+
+
 //utility to get the approx. memory usage of a given BusConfig
 size_t BusConfig::memUsage(unsigned nr) const {
-  if (Bus::isVirtual(type)) {
+  if (Bus::isLoopback(type)) {
+    #ifdef WLED_ENABLE_LOOPBACK_BUS
+    const unsigned depth = pins[0] > 0 && pins[0] < 255 ? pins[0] : WLED_LOOPBACK_FRAMES;
+    return sizeof(BusLoopback) + count * (depth + 1) * sizeof(uint32_t) + depth * sizeof(unsigned long);
+    #else
+    return 0; // not supported in this build (BusManager::add() rejects it)
+    #endif
+  } else if (Bus::isVirtual(type)) {
     return sizeof(BusNetwork) + (count * Bus::getNumberOfChannels(type));
   } else if (Bus::isDigital(type)) {
     return sizeof(BusDigital) + PolyBus::memUsage(count + skipAmount, PolyBus::getI(type, pins, nr)) /*+ doubleBuffer * (count + skipAmount) * Bus::getNumberOfChannels(type)*/;
@@ -788,6 +1012,63 @@ size_t BusManager::memUsage() {
   return size + maxI2S;
 }
 
+// pixel to bus routing: strip is split into spans at every bus start and end, each span lists
+// all (valid) buses containing it (more than one if buses overlap); spans are sorted and do not overlap
+// lookup is a binary search, or O(1) when pixels are accessed sequentially (as in strip.show())
+typedef struct {
+  unsigned start, end;    // [start, end)
+  uint16_t first;         // _spanBus[first .. first+count-1]
+  uint8_t  count;
+} bus_span_t;
+static std::vector<bus_span_t> _spans;
+static std::vector<Bus*>       _spanBus;
+static size_t                  _lastSpan   = 0;
+static bool                    _spansValid = false;
+
+static void buildSpans() {
+  _spans.clear();
+  _spanBus.clear();
+  _lastSpan = 0;
+  std::vector<unsigned> edges;
+  for (const auto &bus : BusManager::busses) {
+    if (!bus->getLength()) continue;
+    edges.push_back(bus->getStart());
+    edges.push_back(bus->getStart() + bus->getLength());
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  for (size_t e = 1; e < edges.size(); e++) {
+    bus_span_t span = { edges[e-1], edges[e], (uint16_t)_spanBus.size(), 0 };
+    for (const auto &bus : BusManager::busses) {
+      if (!bus->getLength() || !bus->containsPixel(span.start)) continue;
+      _spanBus.push_back(bus.get());
+      span.count++;
+    }
+    if (span.count) _spans.push_back(span);
+  }
+  _spansValid = true;
+  DEBUGBUS_PRINTF_P(PSTR("Bus: %u routing spans.\n"), _spans.size());
+}
+
+// returns index of first span ending after pix (_spans.size() if none)
+static size_t IRAM_ATTR findSpan(unsigned pix) {
+  if (!_spansValid) buildSpans();
+  const size_t n = _spans.size();
+  // sequential access: same or next span as last time
+  if (_lastSpan < n && _spans[_lastSpan].start <= pix) {
+    if (pix < _spans[_lastSpan].end) return _lastSpan;
+    if (_lastSpan + 1 < n && pix < _spans[_lastSpan + 1].end) return ++_lastSpan;
+  }
+  size_t lo = 0, hi = n;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (_spans[mid].end <= pix) lo = mid + 1;
+    else hi = mid;
+  }
+  if (lo < n) _lastSpan = lo;
+  return lo;
+}
+
 int BusManager::add(const BusConfig &bc) {
   DEBUGBUS_PRINTF_P(PSTR("Bus: Adding bus (p:%d v:%d)\n"), getNumBusses(), getNumVirtualBusses());
   unsigned digital = 0;
@@ -799,7 +1080,13 @@ int BusManager::add(const BusConfig &bc) {
     if (bus->is2Pin()) twoPin++;
   }
   if (digital > WLED_MAX_DIGITAL_CHANNELS || analog > WLED_MAX_ANALOG_CHANNELS) return -1;
-  if (Bus::isVirtual(bc.type)) {
+  if (Bus::isLoopback(bc.type)) {
+    #ifdef WLED_ENABLE_LOOPBACK_BUS
+    busses.push_back(make_unique<BusLoopback>(bc));
+    #else
+    return -1; // not supported in this build
+    #endif
+  } else if (Bus::isVirtual(bc.type)) {
     busses.push_back(make_unique<BusNetwork>(bc));
   } else if (Bus::isDigital(bc.type)) {
     busses.push_back(make_unique<BusDigital>(bc, Bus::is2Pin(bc.type) ? twoPin : digital));
@@ -808,6 +1095,8 @@ int BusManager::add(const BusConfig &bc) {
   } else {
     busses.push_back(make_unique<BusPwm>(bc));
   }
+  busses.back()->setMaxFps(bc.maxFps);
+  _spansValid = false;
   return busses.size();
 }
 
@@ -831,11 +1120,50 @@ String BusManager::getLEDTypesJSONString() {
   json += LEDTypesToJson(BusOnOff::getLEDTypes());
   json += LEDTypesToJson(BusPwm::getLEDTypes());
   json += LEDTypesToJson(BusNetwork::getLEDTypes());
+  #ifdef WLED_ENABLE_LOOPBACK_BUS
+  json += LEDTypesToJson(BusLoopback::getLEDTypes());
+  #endif
   //json += LEDTypesToJson(BusVirtual::getLEDTypes());
   json.setCharAt(json.length()-1, ']'); // replace last comma with bracket
   return json;
 }
 
+// splits LEDs evenly across outputs, all outputs transmit concurrently so the longest one determines refresh rate
+// fewest outputs that reach targetFps are used (fewer cuts in the strip), if target cannot be reached (or is 0)
+// the layout with highest refresh rate is returned; returns 0 if LEDs do not fit (MAX_LEDS_PER_BUS)
+// only single pin digital types are planned, parallel is set if parallel I2S is required (ESP32, S2 & S3)
+unsigned BusManager::planOutputs(unsigned leds, uint8_t type, unsigned pins, unsigned targetFps, bool &parallel) {
+  #if defined(ESP8266) || defined(CONFIG_IDF_TARGET_ESP32C3)
+  constexpr unsigned singleOutputs = WLED_MAX_DIGITAL_CHANNELS; // no parallel I2S
+  #elif defined(CONFIG_IDF_TARGET_ESP32S3)
+  constexpr unsigned singleOutputs = 4;                         // RMT only
+  #else
+  constexpr unsigned singleOutputs = WLED_MAX_DIGITAL_CHANNELS - 7; // RMT + single I2S (x8 when parallel)
+  #endif
+  parallel = false;
+  if (!leds || !Bus::isDigital(type) || Bus::is2Pin(type)) return 0;
+  const unsigned maxOutputs = std::min(pins, (unsigned)WLED_MAX_DIGITAL_CHANNELS);
+  unsigned best = 0, bestTime = ~0U;
+  for (unsigned n = 1; n <= maxOutputs; n++) {
+    const unsigned perBus = (leds + n - 1) / n;
+    const bool prl = n > singleOutputs;
+    if (perBus > MAX_LEDS_PER_BUS || (prl && perBus > 300)) continue; // parallel I2S limit (see WS2812FX::finalizeInit())
+    const unsigned t = BusDigital::wireTime(type, type == TYPE_WS2812_1CH_X3 ? NUM_ICS_WS2812_1CH_3X(perBus) : perBus);
+    if (t < bestTime) { best = n; bestTime = t; parallel = prl; }
+    if (targetFps && 1000000U / t >= targetFps) break;
+  }
+  return best;
+}
+
+#ifdef WLED_ENABLE_LOOPBACK_BUS
+BusLoopback* BusManager::getLoopback(size_t nr) {
+  for (auto &bus : busses) {
+    if (bus->isOk() && Bus::isLoopback(bus->getType()) && nr-- == 0) return static_cast<BusLoopback*>(bus.get());
+  }
+  return nullptr;
+}
+#endif
+
 void BusManager::useParallelOutput() {
   DEBUGBUS_PRINTLN(F("Bus: Enabling parallel I2S."));
   PolyBus::setParallelI2S1Output();
@@ -851,6 +1179,7 @@ void BusManager::removeAll() {
   //prevents crashes due to deleting busses while in use.
   while (!canAllShow()) yield();
   busses.clear();
+  _spansValid = false;
   PolyBus::setParallelI2S1Output(false);
 }
 
@@ -928,18 +1257,86 @@ void BusManager::off() {
   #endif
 }
 
+static bool _showPending = false; // some bus has changes that were not transmitted with last show()
+
+static void showBus(Bus &bus, unsigned long now) {
+  #ifdef WLED_ENABLE_PERF
+  bus_timing_t &bt = bus.timing();
+  unsigned long start = micros();
+  while (!bus.canShow()) yield(); // show() would block as well, measure it separately
+  unsigned long shown = micros();
+  bus.show();
+  bt.wait += shown - start;
+  bt.show += micros() - shown;
+  bt.shown++;
+  #else
+  bus.show();
+  #endif
+  bus.markShown(now);
+}
+
 void BusManager::show() {
   _gMilliAmpsUsed = 0;
+  _showPending = false;
+  const unsigned long now = millis();
+  // parallel I2S buses are transmitted together, all of them need to be shown on each frame
+  const bool forceDigital = hasParallelOutput();
+  // with more buses a bus still transmitting previous frame (long strip) does not hold back the others,
+  // its changes are shown by showPending() as soon as it is free (each bus runs at its own pace)
+  const bool skipBusy = busses.size() > 1;
   for (auto &bus : busses) {
-    bus->show();
+    #ifdef WLED_ENABLE_PERF
+    bus->timing().frames++;
+    #endif
+    bus->closeFrame();
+    const bool force = forceDigital && bus->isDigital();
+    if (bus->isShowDue(now, force) && (force || !skipBusy || bus->canShow())) showBus(*bus, now);
+    if (bus->isShowPending()) _showPending = true;
     _gMilliAmpsUsed += bus->getUsedCurrent();
   }
 }
 
-void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
+// called from strip service loop between frames: buses that were busy or limited by their max FPS
+// are shown once they can take the frame, so a small fast bus is not clocked by a long slow one
+void BusManager::showPending() {
+  if (!_showPending) return;
+  _showPending = false;
+  const unsigned long now = millis();
   for (auto &bus : busses) {
-    if (!bus->containsPixel(pix)) continue;
+    if (!bus->isShowPending()) continue;
+    if (bus->canShow() && bus->isShowDue(now, false, true)) showBus(*bus, now);
+    else _showPending = true;
+  }
+}
+
+void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
+  const size_t s = findSpan(pix);
+  if (s >= _spans.size() || _spans[s].start > pix) return; // gap between buses
+  for (unsigned b = _spans[s].first; b < _spans[s].first + _spans[s].count; b++) {
+    Bus *bus = _spanBus[b];
     bus->setPixelColor(pix - bus->getStart(), c);
+    bus->hashPixels(&c, 1);
+  }
+}
+
+void IRAM_ATTR BusManager::setPixels(unsigned pix, const uint32_t *c, unsigned n, const uint32_t *linear) {
+  const unsigned end = pix + n;
+  for (size_t s = findSpan(pix); s < _spans.size() && _spans[s].start < end; s++) {
+    const bus_span_t &span = _spans[s];
+    const unsigned from = std::max(pix, span.start);
+    const unsigned to   = std::min(end, span.end);
+    for (unsigned b = span.first; b < span.first + span.count; b++) {
+      Bus *bus = _spanBus[b];
+      #ifdef WLED_ENABLE_PERF
+      unsigned long start = micros();
+      bus->setPixels(from - bus->getStart(), c + (from - pix), to - from, linear ? linear + (from - pix) : nullptr);
+      bus->timing().paint += micros() - start;
+      #else
+      bus->setPixels(from - bus->getStart(), c + (from - pix), to - from, linear ? linear + (from - pix) : nullptr);
+      #endif
+      bus->hashPixels(c + (from - pix), to - from);
+    }
+    _lastSpan = s;
   }
 }
 
@@ -952,12 +1349,61 @@ void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
   Bus::setCCT(cct);
 }
 
-uint32_t BusManager::getPixelColor(unsigned pix) {
+// scales brightness down so that current stays within budget (each LED uses about 1mA in standby, excluded from budget)
+static uint8_t limitBrightness(uint8_t bri, uint32_t milliAmpsFull, unsigned powerBudget, unsigned len) {
+  powerBudget = powerBudget > len ? powerBudget - len : 0;
+  const uint32_t milliAmps = (milliAmpsFull * bri) / 255;
+  if (milliAmps <= powerBudget) return bri;
+  unsigned scaleB = powerBudget * 255 / milliAmps;
+  return ((bri * scaleB) >> 8) + 1;
+}
+
+// single pass ABL: all limits are derived from colors buses collected while painting previous frame
+// (pixels are gamma corrected and routed only once per frame, a sudden change of content exceeds the limit for one frame)
+// 1. global ABL (buses without own limit or PSU group share ablMilliampsMax()) reduces brightness of all buses
+// 2. PSU groups reduce brightness of their buses further if the shared PSU budget is exceeded
+// 3. buses with own limit (per bus ABL) apply it on top of that
+uint8_t BusManager::applyCurrentLimits(uint8_t bri) {
+  uint32_t globalMilliAmps = 0;
+  unsigned globalLen = 0;
+  uint32_t psuMilliAmps[WLED_MAX_PSU_GROUPS] = {0};
+  unsigned psuLen[WLED_MAX_PSU_GROUPS] = {0};
+  for (auto &bus : busses) {
+    if (!bus->hasPowerModel()) continue;
+    const uint32_t milliAmpsFull = bus->estimateCurrent();
+    const unsigned g = bus->getPsu();
+    if (psuMilliampsMax(g)) {
+      psuMilliAmps[g-1] += milliAmpsFull;
+      psuLen[g-1] += bus->getLength();
+    } else if (bus->getMaxCurrent() == 0) { // skip buses with max current per bus defined (PP-ABL)
+      globalMilliAmps += milliAmpsFull;
+      globalLen += bus->getLength();
+    }
+  }
+
+  uint8_t newBri = bri;
+  if (globalLen && _gMilliAmpsMax > MA_FOR_ESP) newBri = limitBrightness(bri, globalMilliAmps, _gMilliAmpsMax - MA_FOR_ESP, globalLen); //80/120mA for ESP power
+  if (newBri != bri) setBrightness(newBri);
+
+  uint8_t psuBri[WLED_MAX_PSU_GROUPS];
+  for (unsigned g = 0; g < WLED_MAX_PSU_GROUPS; g++) {
+    psuBri[g] = psuLen[g] ? limitBrightness(newBri, psuMilliAmps[g], _psuMilliAmpsMax[g], psuLen[g]) : newBri;
+    _psuMilliAmpsUsed[g] = 0;
+  }
+
   for (auto &bus : busses) {
-    if (!bus->containsPixel(pix)) continue;
-    return bus->getPixelColor(pix - bus->getStart());
+    const unsigned g = bus->getPsu();
+    bus->applyCurrentLimit(psuMilliampsMax(g) ? psuBri[g-1] : newBri); // will fill getUsedCurrent()
+    if (g && g <= WLED_MAX_PSU_GROUPS) _psuMilliAmpsUsed[g-1] += bus->getUsedCurrent();
   }
-  return 0;
+  return newBri;
+}
+
+uint32_t BusManager::getPixelColor(unsigned pix) {
+  const size_t s = findSpan(pix);
+  if (s >= _spans.size() || _spans[s].start > pix) return 0; // gap between buses
+  const Bus *bus = _spanBus[_spans[s].first];
+  return bus->getPixelColor(pix - bus->getStart());
 }
 
 bool BusManager::canAllShow() {
@@ -974,9 +1420,12 @@ bool PolyBus::_useParallelI2S = false;
 int16_t Bus::_cct = -1;
 uint8_t Bus::_cctBlend = 0;
 uint8_t Bus::_gAWM = 255;
+uint8_t *Bus::_wbLUT = nullptr;
+int16_t  Bus::_wbKelvin = -1;
 
-uint16_t BusDigital::_milliAmpsTotal = 0;
 
 std::vector<std::unique_ptr<Bus>> BusManager::busses;
 uint16_t BusManager::_gMilliAmpsUsed = 0;
 uint16_t BusManager::_gMilliAmpsMax = ABL_MILLIAMPS_DEFAULT;
+uint16_t BusManager::_psuMilliAmpsUsed[WLED_MAX_PSU_GROUPS] = {0};
+uint16_t BusManager::_psuMilliAmpsMax[WLED_MAX_PSU_GROUPS] = {0};
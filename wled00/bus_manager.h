@@ -99,6 +99,24 @@ typedef struct {
 } LEDType;
 
 
+#ifdef WLED_ENABLE_PERF
+// per bus output timing (us), collected in profiler windows (see perfRoll())
+typedef struct BusTiming {
+  uint32_t paint;   // setPixels(): color conversion & writing into driver buffer
+  uint32_t wait;    // waiting for previous transfer to complete before show()
+  uint32_t show;    // show(): starting transfer (includes encoding into RMT/I2S buffer where driver does it there)
+  uint32_t frames;  // strip frames
+  uint32_t shown;   // frames transmitted (see Bus::isShowDue())
+} bus_timing_t;
+#endif
+
+// FNV-1a style hash of painted colors (per bus dirty detection)
+#define BUS_HASH_SEED  2166136261U
+#define BUS_HASH_PRIME 16777619U
+#ifndef WLED_BUS_KEEPALIVE
+  #define WLED_BUS_KEEPALIVE 1000 // ms, unchanged network buses are resent at least this often (receivers may time out)
+#endif
+
 //parent class of BusDigital, BusPwm, and BusNetwork
 class Bus {
   public:
@@ -110,6 +128,11 @@ class Bus {
     , _reversed(reversed)
     , _valid(false)
     , _needsRefresh(refresh)
+    , _maxFps(0)
+    , _lastShow(0)
+    , _frameHash(BUS_HASH_SEED)
+    , _paintedHash(0)
+    , _shownHash(0)
     {
       _autoWhiteMode = Bus::hasWhite(type) ? aw : RGBW_MODE_MANUAL_ONLY;
     };
@@ -121,6 +144,13 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+    // n consecutive pixels, linear (if not nullptr) holds the same colors before gamma correction (for high precision output)
+    virtual void     setPixels(unsigned pix, const uint32_t *c, unsigned n, const uint32_t *linear = nullptr) { for (unsigned i = 0; i < n; i++) setPixelColor(pix + i, c[i]); }
+    virtual bool     isDithering() const                        { return false; } // output changes every frame
+    virtual bool     hasPowerModel() const                      { return false; } // ABL: bus estimates its current from colors
+    virtual bool     hasCurrentLimit() const                    { return false; } // per bus ABL
+    virtual uint32_t estimateCurrent()                          { return 0; }  // ABL: mA of colors painted since last call at full brightness
+    virtual void     applyCurrentLimit(uint8_t bri)             {}             // ABL: set (limited) brightness before painting
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -132,7 +162,10 @@ class Bus {
     virtual uint16_t getLEDCurrent() const                      { return 0; }
     virtual uint16_t getUsedCurrent() const                     { return 0; }
     virtual uint16_t getMaxCurrent() const                      { return 0; }
+    virtual uint8_t  getPowerModel() const                      { return POWER_MODEL_LINEAR; }
+    virtual uint8_t  getPsu() const                             { return 0; } // PSU group (1-based, 0 = none)
     virtual size_t   getBusSize() const                         { return sizeof(Bus); }
+    virtual unsigned getWireTime() const                        { return 0; } // estimated transmission time of one frame (us)
 
     inline  bool     hasRGB() const                             { return _hasRgb; }
     inline  bool     hasWhite() const                           { return _hasWhite; }
@@ -155,6 +188,19 @@ class Bus {
     inline  bool     isReversed() const                         { return _reversed; }
     inline  bool     isOffRefreshRequired() const               { return _needsRefresh; }
     inline  bool     containsPixel(uint16_t pix) const          { return pix >= _start && pix < _start + _len; }
+    inline  void     setMaxFps(uint8_t fps)                     { _maxFps = fps; }
+    inline  uint8_t  getMaxFps() const                          { return _maxFps; } // 0 = every strip frame
+    // dirty detection: BusManager hashes colors painted to this bus, see isShowDue()
+    inline  void     hashPixels(const uint32_t *c, unsigned n)  { uint32_t h = _frameHash; for (unsigned i = 0; i < n; i++) h = (h ^ c[i]) * BUS_HASH_PRIME; _frameHash = h; }
+    void             closeFrame();  // once per strip frame, before isShowDue()
+    bool             isShowDue(unsigned long now, bool force = false, bool pendingOnly = false);
+    inline  bool     isShowPending() const                      { return _paintedHash != _shownHash; } // painted changes were not transmitted yet
+    inline  void     markShown(unsigned long now)               { _shownHash = _paintedHash; _lastShow = now; }
+    #ifdef WLED_ENABLE_PERF
+    inline  bus_timing_t &timing()                              { return _timing; }
+    inline  const bus_timing_t &lastTiming() const              { return _timingLast; }
+    inline  void     rollTiming()                               { _timingLast = _timing; _timing = {}; }
+    #endif
 
     static inline std::vector<LEDType> getLEDTypes()            { return {{TYPE_NONE, "", PSTR("None")}}; } // not used. just for reference for derived classes
     static constexpr size_t   getNumberOfPins(uint8_t type)     { return isVirtual(type) ? 4 : isPWM(type) ? numPWMPins(type) : is2Pin(type) + 1; } // credit @PaoloTK
@@ -167,7 +213,8 @@ class Bus {
               type == TYPE_SK6812_RGBW || type == TYPE_TM1814 || type == TYPE_UCS8904 ||
               type == TYPE_FW1906 || type == TYPE_WS2805 || type == TYPE_SM16825 ||        // digital types with white channel
               (type > TYPE_ONOFF && type <= TYPE_ANALOG_5CH && type != TYPE_ANALOG_3CH) || // analog types with white channel
-              type == TYPE_NET_DDP_RGBW || type == TYPE_NET_ARTNET_RGBW;                   // network types with white channel
+              type == TYPE_NET_DDP_RGBW || type == TYPE_NET_ARTNET_RGBW ||                 // network types with white channel
+              type == TYPE_LOOPBACK_RGBW;
     }
     static constexpr bool hasCCT(uint8_t type) {
       return  type == TYPE_WS2812_2CH_X3 || type == TYPE_WS2812_WWA ||
@@ -181,6 +228,7 @@ class Bus {
     static constexpr bool  isOnOff(uint8_t type)      { return (type == TYPE_ONOFF); }
     static constexpr bool  isPWM(uint8_t type)        { return (type >= TYPE_ANALOG_MIN && type <= TYPE_ANALOG_MAX); }
     static constexpr bool  isVirtual(uint8_t type)    { return (type >= TYPE_VIRTUAL_MIN && type <= TYPE_VIRTUAL_MAX); }
+    static constexpr bool  isLoopback(uint8_t type)   { return (type == TYPE_LOOPBACK_RGB || type == TYPE_LOOPBACK_RGBW); }
     static constexpr bool  is16bit(uint8_t type)      { return type == TYPE_UCS8903 || type == TYPE_UCS8904 || type == TYPE_SM16825; }
     static constexpr bool  mustRefresh(uint8_t type)  { return type == TYPE_TM1814; }
     static constexpr int   numPWMPins(uint8_t type)   { return (type - 40); }
@@ -213,6 +261,15 @@ class Bus {
       bool _hasCCT;//       : 1;
     //} __attribute__ ((packed));
     uint8_t  _autoWhiteMode;
+    uint8_t  _maxFps;         // limits refresh rate of this bus (0 = no limit)
+    unsigned long _lastShow;  // millis() of last transmission
+    uint32_t _frameHash;      // hash of colors painted since last BusManager::show()
+    uint32_t _paintedHash;    // hash of last painted frame (see closeFrame())
+    uint32_t _shownHash;      // hash of colors last transmitted
+    #ifdef WLED_ENABLE_PERF
+    bus_timing_t _timing;     // current window
+    bus_timing_t _timingLast; // last complete window
+    #endif
     // global Auto White Calculation override
     static uint8_t _gAWM;
     // _cct has the following menaings (see calculateCCT() & BusManager::setSegmentCCT()):
@@ -225,8 +282,23 @@ class Bus {
     //   63 - semi additive/nonlinear (CCT 127 => 66% warm, 66% cold)
     //  127 - additive CCT blending (CCT 127 => 100% warm, 100% cold)
     static uint8_t _cctBlend;
-
-    uint32_t autoWhiteCalc(uint32_t c) const;
+    // white balance correction: per channel gains for _wbKelvin (3x256, allocated on first use)
+    static uint8_t *_wbLUT;
+    static int16_t  _wbKelvin;
+
+    inline  uint8_t  activeAutoWhiteMode() const { return _gAWM < AW_GLOBAL_DISABLED ? _gAWM : _autoWhiteMode; }
+    static uint32_t autoWhiteCalc(uint32_t c, unsigned aWM);
+    inline  uint32_t autoWhiteCalc(uint32_t c) const { return autoWhiteCalc(c, activeAutoWhiteMode()); }
+    // returns white balance LUT for current _cct (nullptr if correction is not active)
+    static const uint8_t *whiteBalanceLUT();
+    // color correction from CCT (same result as colorBalanceFromKelvin(), using LUT)
+    static inline uint32_t colorBalance(uint32_t c) {
+      const uint8_t *lut = whiteBalanceLUT();
+      return lut ? colorBalance(c, lut) : c;
+    }
+    static inline uint32_t colorBalance(uint32_t c, const uint8_t *lut) {
+      return (c & 0xFF000000) | (lut[(c >> 16) & 0xFF] << 16) | (lut[256 + ((c >> 8) & 0xFF)] << 8) | lut[512 + (c & 0xFF)];
+    }
 };
 
 
@@ -240,6 +312,7 @@ class BusDigital : public Bus {
     void setBrightness(uint8_t b) override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixels(unsigned pix, const uint32_t *c, unsigned n, const uint32_t *linear = nullptr) override;
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -249,7 +322,18 @@ class BusDigital : public Bus {
     uint16_t getLEDCurrent() const override  { return _milliAmpsPerLed; }
     uint16_t getUsedCurrent() const override { return _milliAmpsTotal; }
     uint16_t getMaxCurrent() const override  { return _milliAmpsMax; }
+    uint8_t  getPowerModel() const override  { return _powerModel; }
+    uint8_t  getPsu() const override         { return _psu; }
+    bool     hasPowerModel() const override  { return _valid && _milliAmpsPerLed > 0; }
+    bool     hasCurrentLimit() const override;
+    uint32_t estimateCurrent() override;
+    void     applyCurrentLimit(uint8_t bri) override;
     size_t   getBusSize() const override;
+    unsigned getWireTime() const override;
+    static unsigned wireTime(uint8_t type, unsigned ics, uint16_t kHz = 0); // ics includes skipped LEDs
+    #ifdef WLED_ENABLE_DITHERING
+    bool     isDithering() const override    { return _dither; }
+    #endif
     void begin() override;
     void cleanup();
 
@@ -262,10 +346,22 @@ class BusDigital : public Bus {
     uint8_t  _iType;
     uint16_t _frequencykHz;
     uint8_t  _milliAmpsPerLed;
+    uint8_t  _ablBri;         // brightness pixels were painted with (_bri or lower if current limited)
     uint16_t _milliAmpsMax;
+    uint16_t _milliAmpsTotal; // is overwitten/recalculated on each applyCurrentLimit()
+    uint32_t _milliAmpsFull;  // current at full brightness (calculated by estimateCurrent())
+    uint32_t _powerSum;       // sum of channel values painted since last estimateCurrent() (collected by setPixels())
+    uint8_t  _powerModel;
+    uint8_t  _psu;
     void    *_busPtr;
-
-    static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
+    inline bool useMaxRGBPowerModel() const { return _powerModel == POWER_MODEL_MAX_RGB || _milliAmpsPerLed == 255; } // 255: WS2815 preset
+    void     addPowerUsage(const uint32_t *c, unsigned n);
+    #ifdef WLED_ENABLE_DITHERING
+    bool     _dither;         // brightness (and gamma) is applied with 16 bit precision by bus, NPB luminance is not used
+    uint8_t  _ditherFrame;    // frame counter
+    uint8_t  _ditherThr;      // base dithering threshold (bit reversed frame counter, WLED_DITHER_BITS)
+    [[gnu::hot]] uint32_t ditherColor(uint32_t c, const uint16_t *gamma, const uint8_t *wbLUT, unsigned pix) const;
+    #endif
 
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
       if (restoreBri < 255) {
@@ -277,8 +373,6 @@ class BusDigital : public Bus {
       }
       return c;
     }
-
-    uint8_t  estimateCurrentAndLimitBri() const;
 };
 
 
@@ -353,6 +447,42 @@ class BusNetwork : public Bus {
     uint8_t   *_data;
 };
 
+#ifndef WLED_LOOPBACK_FRAMES
+  #define WLED_LOOPBACK_FRAMES 4  // default number of frames kept by loopback bus
+#endif
+#ifdef WLED_ENABLE_LOOPBACK_BUS
+// memory only bus, each transmitted frame (brightness applied) is recorded with its timestamp in a ring buffer
+// it does not use any hardware so complete output pipeline can be tested or benchmarked (also in native builds)
+// "pin" 0 holds ring buffer depth; if "off refresh" is set every frame is recorded, not only changed ones
+class BusLoopback : public Bus {
+  public:
+    BusLoopback(const BusConfig &bc);
+    ~BusLoopback() { cleanup(); }
+
+    [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
+    size_t getPins(uint8_t* pinArray = nullptr) const override;
+    size_t getBusSize() const override  { return sizeof(BusLoopback) + (isOk() ? _len * (_depth + 1U) * sizeof(uint32_t) + _depth * sizeof(unsigned long) : 0); }
+    void   show() override;
+    void   cleanup();
+
+    // recorded frames: back = 0 is the most recent one, returns nullptr if frame does not exist
+    const uint32_t *getFrame(unsigned back = 0, unsigned long *timestamp = nullptr) const;
+    inline unsigned getDepth() const           { return _depth; }
+    inline uint32_t getFramesShown() const     { return _shown; }  // total number of recorded frames
+    inline unsigned getFramesAvailable() const { return std::min(_shown, (uint32_t)_depth); }
+    inline void     clearFrames()              { _shown = 0; }
+
+    static std::vector<LEDType> getLEDTypes();
+
+  private:
+    uint8_t        _depth;
+    uint32_t       _shown;
+    uint32_t      *_data;   // painted pixels (_len) followed by ring buffer (_depth * _len)
+    unsigned long *_stamps; // micros() of each recorded frame
+};
+#endif
+
 
 //temporary struct for passing bus configuration to bus
 struct BusConfig {
@@ -368,8 +498,11 @@ struct BusConfig {
   uint16_t frequency;
   uint8_t milliAmpsPerLed;
   uint16_t milliAmpsMax;
+  uint8_t maxFps;
+  uint8_t powerModel;
+  uint8_t psu;
 
-  BusConfig(uint8_t busType, uint8_t* ppins, uint16_t pstart, uint16_t len = 1, uint8_t pcolorOrder = COL_ORDER_GRB, bool rev = false, uint8_t skip = 0, byte aw=RGBW_MODE_MANUAL_ONLY, uint16_t clock_kHz=0U, uint8_t maPerLed=LED_MILLIAMPS_DEFAULT, uint16_t maMax=ABL_MILLIAMPS_DEFAULT)
+  BusConfig(uint8_t busType, uint8_t* ppins, uint16_t pstart, uint16_t len = 1, uint8_t pcolorOrder = COL_ORDER_GRB, bool rev = false, uint8_t skip = 0, byte aw=RGBW_MODE_MANUAL_ONLY, uint16_t clock_kHz=0U, uint8_t maPerLed=LED_MILLIAMPS_DEFAULT, uint16_t maMax=ABL_MILLIAMPS_DEFAULT, uint8_t fps=0, uint8_t pm=POWER_MODEL_LINEAR, uint8_t psuGroup=0)
   : count(std::max(len,(uint16_t)1))
   , start(pstart)
   , colorOrder(pcolorOrder)
@@ -379,12 +512,15 @@ struct BusConfig {
   , frequency(clock_kHz)
   , milliAmpsPerLed(maPerLed)
   , milliAmpsMax(maMax)
+  , maxFps(fps)
+  , powerModel(pm)
+  , psu(psuGroup)
   {
     refreshReq = (bool) GET_BIT(busType,7);
     type = busType & 0x7F;  // bit 7 may be/is hacked to include refresh info (1=refresh in off state, 0=no refresh)
     size_t nPins = Bus::getNumberOfPins(type);
     for (size_t i = 0; i < nPins; i++) pins[i] = ppins[i];
-    DEBUGBUS_PRINTF_P(PSTR("Bus: Config (%d-%d, type:%d, CO:%d, rev:%d, skip:%d, AW:%d kHz:%d, mA:%d/%d)\n"),
+    DEBUGBUS_PRINTF_P(PSTR("Bus: Config (%d-%d, type:%d, CO:%d, rev:%d, skip:%d, AW:%d kHz:%d, mA:%d/%d, FPS:%d, PM:%d, PSU:%d)\n"),
       (int)start, (int)(start+len),
       (int)type,
       (int)colorOrder,
@@ -392,7 +528,9 @@ struct BusConfig {
       (int)skipAmount,
       (int)autoWhite,
       (int)frequency,
-      (int)milliAmpsPerLed, (int)milliAmpsMax
+      (int)milliAmpsPerLed, (int)milliAmpsMax,
+      (int)maxFps,
+      (int)powerModel, (int)psu
     );
   }
 
@@ -422,12 +560,19 @@ struct BusConfig {
   #endif
 #endif
 
+// buses powered by the same PSU share its current budget (group 0 means bus is limited by global or its own ABL)
+#ifndef WLED_MAX_PSU_GROUPS
+  #define WLED_MAX_PSU_GROUPS 4
+#endif
+
 namespace BusManager {
 
   extern std::vector<std::unique_ptr<Bus>> busses;
   //extern std::vector<Bus*> busses;
   extern uint16_t _gMilliAmpsUsed;
   extern uint16_t _gMilliAmpsMax;
+  extern uint16_t _psuMilliAmpsUsed[WLED_MAX_PSU_GROUPS];
+  extern uint16_t _psuMilliAmpsMax[WLED_MAX_PSU_GROUPS];
 
   #ifdef ESP32_DATA_IDLE_HIGH
   void    esp32RMTInvertIdle() ;
@@ -443,6 +588,10 @@ namespace BusManager {
   //inline uint16_t ablMilliampsMax()             { unsigned sum = 0; for (auto &bus : busses) sum += bus->getMaxCurrent(); return sum; }
   inline uint16_t ablMilliampsMax()             { return _gMilliAmpsMax; }  // used for compatibility reasons (and enabling virtual global ABL)
   inline void     setMilliampsMax(uint16_t max) { _gMilliAmpsMax = max;}
+  // PSU groups are 1-based (as stored in bus config)
+  inline uint16_t psuMilliamps(unsigned g)                    { return g && g <= WLED_MAX_PSU_GROUPS ? _psuMilliAmpsUsed[g-1] : 0; }
+  inline uint16_t psuMilliampsMax(unsigned g)                 { return g && g <= WLED_MAX_PSU_GROUPS ? _psuMilliAmpsMax[g-1] : 0; }
+  inline void     setPsuMilliampsMax(unsigned g, uint16_t max) { if (g && g <= WLED_MAX_PSU_GROUPS) _psuMilliAmpsMax[g-1] = max; }
 
   void useParallelOutput(); // workaround for inaccessible PolyBus
   bool hasParallelOutput(); // workaround for inaccessible PolyBus
@@ -455,9 +604,19 @@ namespace BusManager {
   void off();
 
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+  [[gnu::hot]] void     setPixels(unsigned pix, const uint32_t *c, unsigned n, const uint32_t *linear = nullptr); // n consecutive pixels, split across buses
+  // ABL: buses collect power of colors while they are painted (setPixels()), applyCurrentLimits() applies
+  // global, PSU group and per bus limits derived from previous frame in one go before next frame is painted
+  uint8_t     applyCurrentLimits(uint8_t bri); // returns brightness set by global ABL
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
   void        show();
+  void        showPending(); // between strip frames: transmit changes buses could not take with last show()
   bool        canAllShow();
+  // topology planner: number of digital outputs (of available pins) that LEDs should be split across
+  unsigned    planOutputs(unsigned leds, uint8_t type, unsigned pins, unsigned targetFps, bool &parallel);
+  #ifdef WLED_ENABLE_PERF
+  inline void rollTimings()              { for (auto &bus : busses) bus->rollTiming(); }
+  #endif
   inline void setStatusPixel(uint32_t c) { for (auto &bus : busses) bus->setStatusPixel(c);}
   inline void setBrightness(uint8_t b)   { for (auto &bus : busses) bus->setBrightness(b); }
   // for setSegmentCCT(), cct can only be in [-1,255] range; allowWBCorrection will convert it to K
@@ -465,6 +624,9 @@ namespace BusManager {
   void           setSegmentCCT(int16_t cct, bool allowWBCorrection = false);
   inline int16_t getSegmentCCT()         { return Bus::getCCT(); }
   inline Bus*    getBus(size_t busNr)    { return busNr < busses.size() ? busses[busNr].get() : nullptr; }
+  #ifdef WLED_ENABLE_LOOPBACK_BUS
+  BusLoopback*   getLoopback(size_t nr = 0); // nr-th loopback bus (nullptr if none)
+  #endif
   inline size_t  getNumBusses()          { return busses.size(); }
 
   //semi-duplicate of strip.getLengthTotal() (though that just returns strip._length, calculated in finalizeInit())
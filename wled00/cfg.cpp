@@ -158,6 +158,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   uint16_t total = hw_led[F("total")] | strip.getLengthTotal();
   uint16_t ablMilliampsMax = hw_led[F("maxpwr")] | BusManager::ablMilliampsMax();
   BusManager::setMilliampsMax(ablMilliampsMax);
+  JsonArray psu = hw_led[F("psu")]; // current budgets of PSU groups
+  if (!psu.isNull()) for (unsigned g = 0; g < WLED_MAX_PSU_GROUPS; g++) BusManager::setPsuMilliampsMax(g+1, psu[g] | 0);
   Bus::setGlobalAWMode(hw_led[F("rgbwm")] | AW_GLOBAL_DISABLED);
   CJSON(strip.correctWB, hw_led["cct"]);
   CJSON(strip.cctFromRgb, hw_led[F("cr")]);
@@ -228,6 +230,10 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       uint8_t AWmode = elm[F("rgbwm")] | RGBW_MODE_MANUAL_ONLY;
       uint8_t maPerLed = elm[F("ledma")] | LED_MILLIAMPS_DEFAULT;
       uint16_t maMax = elm[F("maxpwr")] | (ablMilliampsMax * length) / total; // rough (incorrect?) per strip ABL calculation when no config exists
+      uint8_t maxFps = elm[F("fps")] | 0;
+      uint8_t powerModel = elm[F("pm")] | POWER_MODEL_LINEAR;
+      if (powerModel > POWER_MODEL_RGBW_FULL) powerModel = POWER_MODEL_LINEAR; // unknown model
+      uint8_t psuGroup = elm[F("psu")] | 0;
       // To disable brightness limiter we either set output max current to 0 or single LED current to 0 (we choose output max current)
       if (Bus::isPWM(ledType) || Bus::isOnOff(ledType) || Bus::isVirtual(ledType)) { // analog and virtual
         maPerLed = 0;
@@ -235,7 +241,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       }
       ledType |= refresh << 7; // hack bit 7 to indicate strip requires off refresh
 
-      busConfigs.emplace_back(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, maPerLed, maMax);
+      busConfigs.emplace_back(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, maPerLed, maMax, maxFps, powerModel, psuGroup);
       doInitBusses = true;  // finalization done in beginStrip()
       if (!Bus::isVirtual(ledType)) s++; // have as many virtual buses as you want
     }
@@ -912,6 +918,8 @@ void serializeConfig(JsonObject root) {
   JsonObject hw_led = hw.createNestedObject("led");
   hw_led[F("total")] = strip.getLengthTotal(); //provided for compatibility on downgrade and per-output ABL
   hw_led[F("maxpwr")] = BusManager::ablMilliampsMax();
+  JsonArray hw_led_psu = hw_led.createNestedArray(F("psu"));
+  for (unsigned g = 1; g <= WLED_MAX_PSU_GROUPS; g++) hw_led_psu.add(BusManager::psuMilliampsMax(g));
 //  hw_led[F("ledma")] = 0; // no longer used
   hw_led["cct"] = strip.correctWB;
   hw_led[F("cr")] = strip.cctFromRgb;
@@ -975,6 +983,9 @@ void serializeConfig(JsonObject root) {
     ins[F("freq")]   = bus->getFrequency();
     ins[F("maxpwr")] = bus->getMaxCurrent();
     ins[F("ledma")]  = bus->getLEDCurrent();
+    ins[F("fps")]    = bus->getMaxFps();
+    ins[F("pm")]     = bus->getPowerModel();
+    ins[F("psu")]    = bus->getPsu();
   }
 
   JsonArray hw_com = hw.createNestedArray(F("com"));
@@ -86,6 +86,85 @@ uint32_t color_fade(uint32_t c1, uint8_t amount, bool video)
   return scaledcolor;
 }
 
+// SWAR helpers for blurring, process two channels (R+B and W+G) per 32bit operation
+// scale is 1-256 (256 leaves color unchanged), same result as color_fade() (non-video)
+static inline uint32_t fade_swar(uint32_t c, uint32_t scale) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  return ((((c & TWO_CHANNEL_MASK) * scale) >> 8) & TWO_CHANNEL_MASK) | ((((c >> 8) & TWO_CHANNEL_MASK) * scale) & ~TWO_CHANNEL_MASK);
+}
+
+// saturating add, same result as color_add() without preserving color ratios
+static inline uint32_t add_swar(uint32_t c1, uint32_t c2) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb = ( c1       & TWO_CHANNEL_MASK) + ( c2       & TWO_CHANNEL_MASK);
+  uint32_t wg = ((c1 >> 8) & TWO_CHANNEL_MASK) + ((c2 >> 8) & TWO_CHANNEL_MASK);
+  rb |= ((rb >> 8) & 0x00010001) * 0xFF; // channel overflowed: set it to 255
+  wg |= ((wg >> 8) & 0x00010001) * 0xFF;
+  return (rb & TWO_CHANNEL_MASK) | ((wg & TWO_CHANNEL_MASK) << 8);
+}
+
+/*
+ * blurs a line of pixels in place: each pixel keeps "keep" of its value and seeps "seep" to both neighbours
+ * stride is the distance between two pixels of the line (1 for rows, width for columns)
+ * used by Segment::blur() and Segment::blur2D(), operates on raw pixel buffer
+ */
+void blurLine(uint32_t *line, unsigned count, unsigned stride, uint8_t keep, uint8_t seep) {
+  if (count == 0) return;
+  const uint32_t keepScale = keep + 1;
+  const uint32_t seepScale = seep + 1;
+  uint32_t carryover = BLACK;
+  uint32_t lastnew = BLACK;
+  for (unsigned i = 0; i < count; i++) {
+    const uint32_t cur = line[i * stride];
+    const uint32_t part = fade_swar(cur, seepScale);
+    const uint32_t curnew = add_swar(fade_swar(cur, keepScale), carryover);
+    if (i > 0) line[(i - 1) * stride] = add_swar(lastnew, part);
+    lastnew = curnew;
+    carryover = part;
+  }
+  line[(count - 1) * stride] = lastnew;
+}
+
+/*
+ * box blur of a line of pixels in place using a sliding window of 2*radius+1 pixels (window shrinks at the ends)
+ * tmp must hold count pixels, radius is limited to 127 (sums are kept in 16bit per channel)
+ */
+void boxBlurLine(uint32_t *line, unsigned count, unsigned stride, unsigned radius, uint32_t *tmp) {
+  if (count < 2 || radius == 0) return;
+  if (radius > 127) radius = 127;
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  for (unsigned i = 0; i < count; i++) tmp[i] = line[i * stride];
+  uint32_t rbSum = 0, wgSum = 0; // two 16bit sums in each
+  unsigned n = 0; // pixels in window
+  for (unsigned i = 0; i <= radius && i < count; i++, n++) {
+    rbSum += tmp[i] & TWO_CHANNEL_MASK;
+    wgSum += (tmp[i] >> 8) & TWO_CHANNEL_MASK;
+  }
+  unsigned lastN = 0;
+  uint32_t inv = 0;
+  for (unsigned i = 0; i < count; i++) {
+    if (n != lastN) { inv = (0x10000U + n - 1) / n; lastN = n; } // reciprocal, only changes at ends of line
+    const uint32_t r = ((rbSum >> 16)    * inv) >> 16;
+    const uint32_t b = ((rbSum & 0xFFFF) * inv) >> 16;
+    const uint32_t w = ((wgSum >> 16)    * inv) >> 16;
+    const uint32_t g = ((wgSum & 0xFFFF) * inv) >> 16;
+    line[i * stride] = RGBW32(r, g, b, w);
+    // slide window
+    if (i + radius + 1 < count) {
+      const uint32_t c = tmp[i + radius + 1];
+      rbSum += c & TWO_CHANNEL_MASK;
+      wgSum += (c >> 8) & TWO_CHANNEL_MASK;
+      n++;
+    }
+    if (i >= radius) {
+      const uint32_t c = tmp[i - radius];
+      rbSum -= c & TWO_CHANNEL_MASK;
+      wgSum -= (c >> 8) & TWO_CHANNEL_MASK;
+      n--;
+    }
+  }
+}
+
 // 1:1 replacement of fastled function optimized for ESP, slightly faster, more accurate and uses less flash (~ -200bytes)
 uint32_t ColorFromPaletteWLED(const CRGBPalette16& pal, unsigned index, uint8_t brightness, TBlendType blendType)
 {
@@ -567,6 +646,14 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb) {
 // gamma lookup tables used for color correction (filled on 1st use (cfg.cpp & set.cpp))
 uint8_t NeoGammaWLEDMethod::gammaT[256];
 uint8_t NeoGammaWLEDMethod::gammaT_inv[256];
+#ifdef WLED_ENABLE_DITHERING
+uint16_t NeoGammaWLEDMethod::gammaT16[256];
+
+// used by bus manager, returns nullptr if gamma correction is disabled
+const uint16_t *gamma16Table() {
+  return gammaCorrectCol ? NeoGammaWLEDMethod::rawGamma16Table() : nullptr;
+}
+#endif
 
 // re-calculates & fills gamma tables
 void NeoGammaWLEDMethod::calcGammaTable(float gamma)
@@ -575,6 +662,9 @@ void NeoGammaWLEDMethod::calcGammaTable(float gamma)
   for (size_t i = 0; i < 256; i++) {
     gammaT[i] = (int)(powf((float)i / 255.0f, gamma) * 255.0f + 0.5f);
     gammaT_inv[i] = (int)(powf((float)i / 255.0f, gamma_inv) * 255.0f + 0.5f);
+    #ifdef WLED_ENABLE_DITHERING
+    gammaT16[i] = (int)(powf((float)i / 255.0f, gamma) * 65535.0f + 0.5f);
+    #endif
   }
 }
 
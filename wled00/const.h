@@ -323,6 +323,8 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGBW     89            //network ArtNet RGB bus (master broadcast bus, unused)
+#define TYPE_LOOPBACK_RGB        90            //memory only bus recording shown frames (tests & benchmarks, requires WLED_ENABLE_LOOPBACK_BUS)
+#define TYPE_LOOPBACK_RGBW       91            //memory only RGBW bus
 #define TYPE_VIRTUAL_MAX         95
 
 //Color orders
@@ -520,6 +522,11 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
   #endif
 #endif
 
+// ABL power models (how LED current follows channel values, mA/LED is current of full white)
+#define POWER_MODEL_LINEAR    0 // sum of channels, RGBW white shares LED current with RGB (12mA/LED WS2815 setting uses max RGB)
+#define POWER_MODEL_MAX_RGB   1 // brightest of R, G, B drives the whole LED, white ignored (WS2815 & other 12V ICs with LEDs in series)
+#define POWER_MODEL_RGBW_FULL 2 // white channel draws as much as each of R, G, B (separate white die at full current)
+
 // PWM settings
 #ifndef WLED_PWM_FREQ
 #ifdef ESP8266
@@ -162,10 +162,19 @@ class NeoGammaWLEDMethod {
     static void calcGammaTable(float gamma);                    // re-calculates & fills gamma tables
     static inline uint8_t rawGamma8(uint8_t val) { return gammaT[val]; }  // get value from Gamma table (WLED specific, not used by NPB)
     static inline uint8_t rawInverseGamma8(uint8_t val) { return gammaT_inv[val]; }  // get value from inverse Gamma table (WLED specific, not used by NPB)
+    #ifdef WLED_ENABLE_DITHERING
+    static inline const uint16_t *rawGamma16Table() { return gammaT16; }  // 16 bit Gamma table (dithered bus output)
+    #endif
   private:
     static uint8_t gammaT[];
     static uint8_t gammaT_inv[];
+    #ifdef WLED_ENABLE_DITHERING
+    static uint16_t gammaT16[];
+    #endif
 };
+#ifdef WLED_ENABLE_DITHERING
+const uint16_t *gamma16Table(); // nullptr if gamma correction is disabled
+#endif
 #define gamma32(c) NeoGammaWLEDMethod::Correct32(c)
 #define gamma8(c)  NeoGammaWLEDMethod::rawGamma8(c)
 #define gamma32inv(c) NeoGammaWLEDMethod::inverseGamma32(c)
@@ -174,6 +183,8 @@ class NeoGammaWLEDMethod {
 inline uint32_t color_blend16(uint32_t c1, uint32_t c2, uint16_t b) { return color_blend(c1, c2, b >> 8); };
 [[gnu::hot, gnu::pure]] uint32_t color_add(uint32_t, uint32_t, bool preserveCR = false);
 [[gnu::hot, gnu::pure]] uint32_t color_fade(uint32_t c1, uint8_t amount, bool video=false);
+[[gnu::hot]] void blurLine(uint32_t *line, unsigned count, unsigned stride, uint8_t keep, uint8_t seep);
+[[gnu::hot]] void boxBlurLine(uint32_t *line, unsigned count, unsigned stride, unsigned radius, uint32_t *tmp);
 [[gnu::hot, gnu::pure]] uint32_t ColorFromPaletteWLED(const CRGBPalette16 &pal, unsigned index, uint8_t brightness = (uint8_t)255U, TBlendType blendType = LINEARBLEND);
 CRGBPalette16 generateHarmonicRandomPalette(const CRGBPalette16 &basepalette);
 CRGBPalette16 generateRandomPalette();
@@ -239,6 +250,8 @@ unsigned long filePositionCallback(void);
 int fileReadCallback(void);
 int fileReadBlockCallback(void * buffer, int numberOfBytes);
 int fileSizeCallback(void);
+#endif
+#if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
 byte renderImageToSegment(Segment &seg);
 void endImagePlayback(Segment* seg);
 #endif
@@ -273,6 +286,9 @@ bool deserializeState(JsonObject root, byte callMode = CALL_MODE_DIRECT_CHANGE,
 void serializeSegment(const JsonObject& root, const Segment& seg, byte id, bool forPreset = false, bool segmentBounds = true);
 void serializeState(JsonObject root, bool forPreset = false, bool includeBri = true, bool segmentBounds = true, bool selectedSegmentsOnly = false);
 void serializeInfo(JsonObject root);
+#ifdef WLED_ENABLE_PERF
+void serializePerf(JsonObject root);
+#endif
 void serializeModeNames(JsonArray arr);
 void serializeModeData(JsonArray fxdata);
 void serveJson(AsyncWebServerRequest* request);
@@ -1,19 +1,72 @@
 #include "wled.h"
 
+#if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
+
+/*
+ * Functions to render images from filesystem to segments, used by the "Image" effect
+ */
+
+#define IMAGE_ERROR_NONE 0
+#define IMAGE_ERROR_NO_NAME 1
+#define IMAGE_ERROR_SEG_LIMIT 2
+#define IMAGE_ERROR_UNSUPPORTED_FORMAT 3
+#define IMAGE_ERROR_FILE_MISSING 4
+#define IMAGE_ERROR_DECODER_ALLOC 5
+#define IMAGE_ERROR_GIF_DECODE 6
+#define IMAGE_ERROR_FRAME_DECODE 7
+#define IMAGE_ERROR_WAITING 254
+#define IMAGE_ERROR_PREV 255
+
 #ifdef WLED_ENABLE_GIF
 
 #include "GifDecoder.h"
 
+// number of segments that may play images at the same time
+#ifndef WLED_MAX_IMAGE_SEGMENTS
+  #define WLED_MAX_IMAGE_SEGMENTS 4
+#endif
+// max amount of memory used for cached (decoded) frames of a single segment
+#ifndef WLED_IMAGE_CACHE_SIZE
+  #define WLED_IMAGE_CACHE_SIZE (16*1024)
+#endif
+#ifndef WLED_IMAGE_CACHE_SIZE_PSRAM
+  #define WLED_IMAGE_CACHE_SIZE_PSRAM (512*1024)
+#endif
 
 /*
- * Functions to render images from filesystem to segments, used by the "Image" effect
+ * GIF frames are decoded by a single (shared) decoder directly into a per-segment frame cache, pre-scaled to segment dimensions.
+ * Once the animation loops all frames are cached and the decoder is released for other segments, playback then only copies
+ * cached frames. If an animation does not fit into the cache the segment decodes into a single frame (streaming), it keeps
+ * the decoder only while no other segment needs it and resumes from the stored file position when it gets it back.
  */
+typedef struct {
+  Segment      *seg;
+  char          filename[34];
+  uint16_t      width, height;  // (virtual) segment dimensions frames were scaled to
+  uint16_t      frameCount;     // frames in cache
+  uint16_t      current;        // frame currently displayed
+  uint16_t     *delays;         // frame delays in ms
+  uint8_t      *frames;         // RGB frames, width*height*3 bytes each
+  unsigned long lastFrameTime;
+  unsigned long lastUsed;
+  uint32_t      resumePosition; // file position of next frame if streaming player released decoder (0 = start)
+  bool          complete;       // all frames are cached, decoder no longer needed
+  bool          streaming;      // animation does not fit into cache, frames holds a single frame
+  bool          failed;
+} image_player_t;
+
+static image_player_t  players[WLED_MAX_IMAGE_SEGMENTS];
+static image_player_t *decoderOwner = nullptr; // player currently using decoder (and file)
+static uint8_t        *drawTarget = nullptr;   // frame decoder draws into
+static uint16_t        targetWidth, targetHeight;
+static uint32_t        scaleX, scaleY;         // gif to segment scale (16.16 fixed point)
+static uint8_t         repeatX, repeatY;       // pixels set per gif pixel when upscaling
+static uint32_t        lastFilePosition;       // used to detect when animation loops
+static bool            decoderWanted = false;  // another player is waiting for the decoder
 
 File file;
-char lastFilename[34] = "/";
 GifDecoder<320,320,12,true> decoder;
-bool gifDecodeFailed = false;
-unsigned long lastFrameDisplayTime = 0, currentFrameDelay = 0;
+uint16_t gifWidth, gifHeight;
 
 bool fileSeekCallback(unsigned long position) {
   return file.seek(position);
@@ -35,110 +88,394 @@ int fileSizeCallback(void) {
   return file.size();
 }
 
-bool openGif(const char *filename) {
-  file = WLED_FS.open(filename, "r");
+void screenClearCallback(void) {
+  if (drawTarget) memset(drawTarget, 0, targetWidth * targetHeight * 3);
+}
+
+void updateScreenCallback(void) {}
+
+void drawPixelCallback(int16_t x, int16_t y, uint8_t red, uint8_t green, uint8_t blue) {
+  if (!drawTarget) return;
+  // simple nearest-neighbor scaling, set multiple pixels if upscaling
+  const unsigned outX = (x * scaleX) >> 16;
+  const unsigned outY = (y * scaleY) >> 16;
+  const uint8_t r = gamma8(red), g = gamma8(green), b = gamma8(blue);
+  for (unsigned j = 0; j < repeatY && outY + j < targetHeight; j++) {
+    uint8_t *p = drawTarget + ((outY + j) * targetWidth + outX) * 3;
+    for (unsigned i = 0; i < repeatX && outX + i < targetWidth; i++) {
+      *p++ = r; *p++ = g; *p++ = b;
+    }
+  }
+}
+
+static void releaseDecoder() {
+  if (file) file.close();
+  decoder.dealloc();
+  decoderOwner = nullptr;
+}
 
-  if (!file) return false;
-  return true;
+static void releasePlayer(image_player_t &pl) {
+  if (decoderOwner == &pl) releaseDecoder();
+  p_free(pl.frames);
+  p_free(pl.delays);
+  memset(&pl, 0, sizeof(image_player_t));
 }
 
-Segment* activeSeg;
-uint16_t gifWidth, gifHeight;
+// returns player assigned to segment, assigns a free (or no longer used) one if needed
+static image_player_t *getPlayer(Segment &seg) {
+  image_player_t *freePlayer = nullptr;
+  for (image_player_t &pl : players) {
+    if (pl.seg == &seg) return &pl;
+    if (!freePlayer && (!pl.seg || millis() - pl.lastUsed > 2000)) freePlayer = &pl; // segment stopped playing (or was deleted)
+  }
+  if (freePlayer) {
+    releasePlayer(*freePlayer);
+    freePlayer->seg = &seg;
+  }
+  return freePlayer;
+}
 
-void screenClearCallback(void) {
-  activeSeg->fill(0);
+static byte acquireDecoder(image_player_t &pl) {
+  if (decoderOwner == &pl) return IMAGE_ERROR_NONE;
+  if (decoderOwner) { decoderWanted = true; return IMAGE_ERROR_WAITING; } // another segment is decoding
+  file = WLED_FS.open(pl.filename, "r");
+  if (!file) return IMAGE_ERROR_FILE_MISSING;
+  decoderOwner = &pl;
+  decoderWanted = false; // waiting players will ask again
+  decoder.setScreenClearCallback(screenClearCallback);
+  decoder.setUpdateScreenCallback(updateScreenCallback);
+  decoder.setDrawPixelCallback(drawPixelCallback);
+  decoder.setFileSeekCallback(fileSeekCallback);
+  decoder.setFilePositionCallback(filePositionCallback);
+  decoder.setFileReadCallback(fileReadCallback);
+  decoder.setFileReadBlockCallback(fileReadBlockCallback);
+  decoder.setFileSizeCallback(fileSizeCallback);
+  decoder.alloc();
+  DEBUG_PRINTLN(F("Starting decoding"));
+  if (decoder.startDecoding() < 0) { releaseDecoder(); return IMAGE_ERROR_GIF_DECODE; }
+  decoder.getSize(&gifWidth, &gifHeight);
+  if (!gifWidth || !gifHeight) { releaseDecoder(); return IMAGE_ERROR_GIF_DECODE; }
+  DEBUG_PRINTLN(F("Decoding started"));
+  targetWidth  = pl.width;
+  targetHeight = pl.height;
+  scaleX  = (uint32_t(pl.width)  << 16) / gifWidth;
+  scaleY  = (uint32_t(pl.height) << 16) / gifHeight;
+  repeatX = (pl.width  + gifWidth  - 1) / gifWidth;
+  repeatY = (pl.height + gifHeight - 1) / gifHeight;
+  lastFilePosition = 0;
+  if (pl.resumePosition) {
+    // streaming player continues where it released the decoder (global palette was read by startDecoding())
+    if (!file.seek(pl.resumePosition)) { releaseDecoder(); return IMAGE_ERROR_GIF_DECODE; }
+    lastFilePosition = pl.resumePosition;
+  }
+  return IMAGE_ERROR_NONE;
 }
 
-void updateScreenCallback(void) {}
+// decodes next frame into cache (or single frame buffer if streaming) and makes it current
+static byte decodeNextFrame(image_player_t &pl) {
+  const size_t frameSize = pl.width * pl.height * 3;
+  uint8_t *target = pl.frames;
+  if (!pl.streaming) {
+    size_t cacheLimit = WLED_IMAGE_CACHE_SIZE;
+    #ifdef ARDUINO_ARCH_ESP32
+    if (psramSafe && psramFound()) cacheLimit = WLED_IMAGE_CACHE_SIZE_PSRAM;
+    #endif
+    const size_t newSize = (pl.frameCount + 1) * frameSize;
+    uint8_t  *frames = (newSize <= cacheLimit || pl.frameCount == 0) ? static_cast<uint8_t*>(p_realloc(pl.frames, newSize)) : nullptr;
+    if (frames) pl.frames = frames;
+    uint16_t *delays = frames ? static_cast<uint16_t*>(p_realloc(pl.delays, (pl.frameCount + 1) * sizeof(uint16_t))) : nullptr;
+    if (delays) pl.delays = delays;
+    if (!frames || !delays) {
+      if (pl.frameCount == 0) return IMAGE_ERROR_DECODER_ALLOC;
+      // cache is full: keep last frame only (next frame is drawn over it) and decode each frame from now on
+      DEBUG_PRINTF_P(PSTR("Image cache full after %u frames, streaming %s\n"), pl.frameCount, pl.filename);
+      memmove(pl.frames, pl.frames + (pl.frameCount - 1) * frameSize, frameSize);
+      pl.delays[0] = pl.delays[pl.frameCount - 1];
+      pl.frameCount = 1;
+      pl.streaming = true;
+      // give back cache memory not needed for a single frame
+      frames = static_cast<uint8_t*>(p_realloc(pl.frames, frameSize));
+      if (frames) pl.frames = frames;
+      delays = static_cast<uint16_t*>(p_realloc(pl.delays, sizeof(uint16_t)));
+      if (delays) pl.delays = delays;
+      target = pl.frames;
+    } else {
+      target = pl.frames + pl.frameCount * frameSize;
+      if (pl.frameCount) memcpy(target, target - frameSize, frameSize); // frames are drawn over previous frame
+      else               memset(target, 0, frameSize);
+    }
+  }
 
-void drawPixelCallback(int16_t x, int16_t y, uint8_t red, uint8_t green, uint8_t blue) {
-  // simple nearest-neighbor scaling 
-  int16_t outY = y * activeSeg->height() / gifHeight;
-  int16_t outX = x * activeSeg->width()  / gifWidth;
-  // set multiple pixels if upscaling
-  for (int16_t i = 0; i < (activeSeg->width()+(gifWidth-1)) / gifWidth; i++) {
-    for (int16_t j = 0; j < (activeSeg->height()+(gifHeight-1)) / gifHeight; j++) {
-      activeSeg->setPixelColorXY(outX + i, outY + j, gamma8(red), gamma8(green), gamma8(blue));
+  drawTarget = target;
+  int result = decoder.decodeFrame(false);
+  drawTarget = nullptr;
+  if (result < 0) return IMAGE_ERROR_FRAME_DECODE;
+
+  const uint32_t position = file.position();
+  if (!pl.streaming && pl.frameCount > 0 && position <= lastFilePosition) {
+    // decoder started over with first frame, all frames are cached: drop duplicate and release decoder for other segments
+    uint8_t *frames = static_cast<uint8_t*>(p_realloc(pl.frames, pl.frameCount * frameSize));
+    if (frames) pl.frames = frames;
+    pl.complete = true;
+    pl.current = 0;
+    releaseDecoder();
+    DEBUG_PRINTF_P(PSTR("Image %s cached: %u frames\n"), pl.filename, pl.frameCount);
+    return IMAGE_ERROR_NONE;
+  }
+  lastFilePosition = position;
+  if (pl.streaming) {
+    pl.delays[0] = decoder.getFrameDelay_ms();
+    if (decoderWanted) {
+      // streaming never completes: let other segments decode and resume from here later
+      pl.resumePosition = position;
+      releaseDecoder();
     }
+  } else {
+    pl.delays[pl.frameCount] = decoder.getFrameDelay_ms();
+    pl.current = pl.frameCount++;
   }
+  return IMAGE_ERROR_NONE;
 }
 
-#define IMAGE_ERROR_NONE 0
-#define IMAGE_ERROR_NO_NAME 1
-#define IMAGE_ERROR_SEG_LIMIT 2
-#define IMAGE_ERROR_UNSUPPORTED_FORMAT 3
-#define IMAGE_ERROR_FILE_MISSING 4
-#define IMAGE_ERROR_DECODER_ALLOC 5
-#define IMAGE_ERROR_GIF_DECODE 6
-#define IMAGE_ERROR_FRAME_DECODE 7
-#define IMAGE_ERROR_WAITING 254
-#define IMAGE_ERROR_PREV 255
+#endif // WLED_ENABLE_GIF
+
+#ifdef WLED_ENABLE_FSEQ
+
+#if defined(WLED_USE_SD_MMC)
+  #include "SD_MMC.h"
+  #define FSEQ_SD_ADAPTER SD_MMC
+#elif defined(WLED_USE_SD_SPI)
+  #include "SD.h"
+  #define FSEQ_SD_ADAPTER SD
+#endif
+
+// size of read-ahead buffer (holds as many consecutive frames as fit, at least one)
+#ifndef FSEQ_READAHEAD_SIZE
+  #ifdef ESP8266
+    #define FSEQ_READAHEAD_SIZE 2048
+  #else
+    #define FSEQ_READAHEAD_SIZE 8192
+  #endif
+#endif
+
+/*
+ * FSEQ v2 (xLights/FPP sequence) playback, uncompressed sequences with or without sparse ranges
+ * Frame to display is derived from strip.now (which includes timebase) and sequence step time so all segments
+ * (and all synced instances) play the same frame at file's frame rate.
+ * Each segment displays channels matching its position on the strip: LED i (logical index, row major for 2D)
+ * uses channels 3*i (R), 3*i+1 (G) and 3*i+2 (B).
+ * Sequence is read from LittleFS or SD card (if sd_card usermod is compiled in and file is not on LittleFS).
+ */
+static File     fseqFile;
+static char     fseqFilename[34] = "/";
+static Segment *fseqOwner = nullptr;  // segment that opened the sequence, other segments may play the same sequence
+static bool     fseqFailed = false;
+static uint8_t *fseqBuffer = nullptr; // read-ahead buffer
+static uint32_t fseqBufFirst = 0;     // first frame in buffer
+static uint16_t fseqBufFrames = 0;    // number of frames in buffer
+static uint16_t fseqBufCapacity = 0;  // max number of frames in buffer
+static uint32_t fseqDataOffset = 0;   // start of channel data in file
+static uint32_t fseqChannels = 0;     // bytes per frame
+static uint32_t fseqFrames = 0;
+static uint8_t  fseqStepTime = 0;     // ms per frame
+static uint8_t  fseqNumRanges = 0;    // number of sparse ranges (0 = all channels present)
+static uint32_t *fseqRanges = nullptr; // sparse ranges (start channel, channel count)
+
+static inline uint32_t fseqRead24(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16); }
+static inline uint32_t fseqRead32(const uint8_t *p) { return fseqRead24(p) | (uint32_t(p[3]) << 24); }
+
+static void closeFseq() {
+  if (fseqFile) fseqFile.close();
+  p_free(fseqBuffer);
+  p_free(fseqRanges);
+  fseqBuffer = nullptr;
+  fseqRanges = nullptr;
+  fseqNumRanges = 0;
+  fseqBufFrames = 0;
+  fseqOwner = nullptr;
+  fseqFailed = false;
+  fseqFilename[1] = '\0';
+}
+
+static byte openFseq() {
+  fseqFile = WLED_FS.open(fseqFilename, "r");
+  #ifdef FSEQ_SD_ADAPTER
+  if (!fseqFile) fseqFile = FSEQ_SD_ADAPTER.open(fseqFilename, "r");
+  #endif
+  if (!fseqFile) return IMAGE_ERROR_FILE_MISSING;
+
+  uint8_t hdr[32];
+  if (fseqFile.read(hdr, sizeof(hdr)) != sizeof(hdr) || memcmp_P(hdr, PSTR("PSEQ"), 4) != 0 || hdr[7] != 2) return IMAGE_ERROR_UNSUPPORTED_FORMAT;
+  if (hdr[20] & 0x0F) return IMAGE_ERROR_UNSUPPORTED_FORMAT; // compressed sequences (zstd/zlib) are not supported
+  fseqDataOffset = hdr[4] | (hdr[5] << 8);
+  fseqChannels   = fseqRead32(hdr + 10);
+  fseqFrames     = fseqRead32(hdr + 14);
+  fseqStepTime   = hdr[18];
+  unsigned blocks = hdr[21] | ((hdr[20] & 0xF0) << 4); // compression block index precedes sparse ranges
+  fseqNumRanges  = hdr[22];
+  if (!fseqChannels || !fseqFrames || !fseqStepTime || fseqDataOffset < sizeof(hdr)) return IMAGE_ERROR_UNSUPPORTED_FORMAT;
+  // truncated file: play what is there
+  if (fseqFile.size() < fseqDataOffset + fseqFrames * fseqChannels) fseqFrames = (fseqFile.size() - fseqDataOffset) / fseqChannels;
+  if (!fseqFrames) return IMAGE_ERROR_FRAME_DECODE;
+
+  if (fseqNumRanges) {
+    fseqRanges = static_cast<uint32_t*>(p_malloc(2 * fseqNumRanges * sizeof(uint32_t)));
+    if (!fseqRanges || !fseqFile.seek(sizeof(hdr) + 8 * blocks)) return IMAGE_ERROR_DECODER_ALLOC;
+    for (unsigned r = 0; r < fseqNumRanges; r++) {
+      uint8_t range[6];
+      if (fseqFile.read(range, sizeof(range)) != sizeof(range)) return IMAGE_ERROR_UNSUPPORTED_FORMAT;
+      fseqRanges[2*r]   = fseqRead24(range);
+      fseqRanges[2*r+1] = fseqRead24(range + 3);
+    }
+  }
+
+  fseqBufCapacity = constrain(FSEQ_READAHEAD_SIZE / fseqChannels, (uint32_t)1, min(fseqFrames, (uint32_t)0xFFFF));
+  fseqBuffer = static_cast<uint8_t*>(p_malloc(fseqBufCapacity * fseqChannels));
+  if (!fseqBuffer) return IMAGE_ERROR_DECODER_ALLOC;
+  fseqBufFrames = 0;
+  DEBUG_PRINTF_P(PSTR("FSEQ %s: %u ch, %u frames @ %ums, %u ranges, %u frames buffered\n"), fseqFilename, fseqChannels, fseqFrames, fseqStepTime, fseqNumRanges, fseqBufCapacity);
+  return IMAGE_ERROR_NONE;
+}
+
+// returns offset of channel (and the next two) within frame data or -1 if not present in sequence
+static int fseqChannelOffset(uint32_t ch) {
+  if (!fseqNumRanges) return ch + 3 <= fseqChannels ? ch : -1;
+  uint32_t offset = 0;
+  for (unsigned r = 0; r < fseqNumRanges; r++) {
+    const uint32_t start = fseqRanges[2*r], count = fseqRanges[2*r+1];
+    if (ch >= start && ch + 3 <= start + count) return offset + ch - start + 3 <= fseqChannels ? offset + ch - start : -1;
+    offset += count;
+  }
+  return -1;
+}
 
-// renders an image (.gif only; .bmp and .fseq to be added soon) from FS to a segment
+static byte renderFseqToSegment(Segment &seg) {
+  if (strncmp(fseqFilename +1, seg.name, 32) != 0) { // not the sequence currently open
+    if (fseqOwner && fseqOwner != &seg) return IMAGE_ERROR_SEG_LIMIT; // only one sequence at a time
+    closeFseq();
+    strncpy(fseqFilename +1, seg.name, 32);
+    fseqOwner = &seg;
+    byte result = openFseq();
+    if (result != IMAGE_ERROR_NONE) { fseqFailed = true; return result; }
+  }
+  if (fseqFailed) return IMAGE_ERROR_PREV;
+
+  const uint32_t frame = (strip.now / fseqStepTime) % fseqFrames;
+  if (frame < fseqBufFirst || frame >= fseqBufFirst + fseqBufFrames) {
+    // read ahead as many consecutive frames as fit in buffer (single block read)
+    const unsigned count = min(uint32_t(fseqBufCapacity), fseqFrames - frame);
+    const size_t bytes = count * fseqChannels;
+    fseqBufFrames = 0;
+    if (!fseqFile.seek(fseqDataOffset + frame * fseqChannels) || fseqFile.read(fseqBuffer, bytes) != bytes) {
+      fseqFailed = true;
+      return IMAGE_ERROR_FRAME_DECODE;
+    }
+    fseqBufFirst  = frame;
+    fseqBufFrames = count;
+  }
+  const uint8_t *data = fseqBuffer + (frame - fseqBufFirst) * fseqChannels;
+
+  const unsigned cols = seg.is2D() ? Segment::vWidth() : Segment::vLength();
+  const unsigned rows = seg.is2D() ? Segment::vHeight() : 1;
+  for (unsigned y = 0; y < rows; y++) {
+    for (unsigned x = 0; x < cols; x++) {
+      const int offset = fseqChannelOffset(3 * ((seg.startY + y) * Segment::maxWidth + seg.start + x));
+      const uint32_t c = offset < 0 ? BLACK : RGBW32(data[offset], data[offset+1], data[offset+2], 0);
+      if (seg.is2D()) seg.setPixelColorXY(x, y, c);
+      else            seg.setPixelColor(x, c);
+    }
+  }
+  return IMAGE_ERROR_NONE;
+}
+
+static void endFseqPlayback(Segment *seg) {
+  if (fseqOwner != seg) return;
+  closeFseq();
+  DEBUG_PRINTLN(F("FSEQ playback ended"));
+}
+
+#endif // WLED_ENABLE_FSEQ
+
+// renders an image (.gif or .fseq; .bmp to be added soon) from FS to a segment
 byte renderImageToSegment(Segment &seg) {
   if (!seg.name) return IMAGE_ERROR_NO_NAME;
+  #ifdef WLED_ENABLE_FSEQ
+  size_t nameLen = strlen(seg.name);
+  if (nameLen > 5 && strcmp_P(seg.name + nameLen - 5, PSTR(".fseq")) == 0) return renderFseqToSegment(seg);
+  #endif
+  #ifndef WLED_ENABLE_GIF
+  return IMAGE_ERROR_UNSUPPORTED_FORMAT;
+  #else
   // disable during effect transition, causes flickering, multiple allocations and depending on image, part of old FX remaining
   //if (seg.mode != seg.currentMode()) return IMAGE_ERROR_WAITING;
-  if (activeSeg && activeSeg != &seg) return IMAGE_ERROR_SEG_LIMIT; // only one segment at a time
-  activeSeg = &seg;
-
-  if (strncmp(lastFilename +1, seg.name, 32) != 0) { // segment name changed, load new image
-    strncpy(lastFilename +1, seg.name, 32);
-    gifDecodeFailed = false;
-    if (strcmp(lastFilename + strlen(lastFilename) - 4, ".gif") != 0) {
-      gifDecodeFailed = true;
+  image_player_t *pl = getPlayer(seg);
+  if (!pl) return IMAGE_ERROR_SEG_LIMIT; // too many segments playing images
+  pl->lastUsed = millis();
+
+  const unsigned width  = Segment::vWidth();
+  const unsigned height = Segment::vHeight();
+  if (strncmp(pl->filename +1, seg.name, 32) != 0 || pl->width != width || pl->height != height) {
+    // segment name or dimensions changed, load new image (frames are scaled to segment dimensions)
+    releasePlayer(*pl);
+    pl->seg = &seg;
+    pl->lastUsed = millis();
+    pl->filename[0] = '/';
+    strncpy(pl->filename +1, seg.name, 32);
+    pl->width  = width;
+    pl->height = height;
+    if (strcmp(pl->filename + strlen(pl->filename) - 4, ".gif") != 0) {
+      pl->failed = true;
       return IMAGE_ERROR_UNSUPPORTED_FORMAT;
     }
-    if (file) file.close();
-    openGif(lastFilename);
-    if (!file) { gifDecodeFailed = true; return IMAGE_ERROR_FILE_MISSING; }
-    decoder.setScreenClearCallback(screenClearCallback);
-    decoder.setUpdateScreenCallback(updateScreenCallback);
-    decoder.setDrawPixelCallback(drawPixelCallback);
-    decoder.setFileSeekCallback(fileSeekCallback);
-    decoder.setFilePositionCallback(filePositionCallback);
-    decoder.setFileReadCallback(fileReadCallback);
-    decoder.setFileReadBlockCallback(fileReadBlockCallback);
-    decoder.setFileSizeCallback(fileSizeCallback);
-    decoder.alloc();
-    DEBUG_PRINTLN(F("Starting decoding"));
-    if(decoder.startDecoding() < 0) { gifDecodeFailed = true; return IMAGE_ERROR_GIF_DECODE; }
-    DEBUG_PRINTLN(F("Decoding started"));
-  }
-
-  if (gifDecodeFailed) return IMAGE_ERROR_PREV;
-  if (!file) { gifDecodeFailed = true; return IMAGE_ERROR_FILE_MISSING; }
-  //if (!decoder) { gifDecodeFailed = true; return IMAGE_ERROR_DECODER_ALLOC; }
-
-  // speed 0 = half speed, 128 = normal, 255 = full FX FPS
-  // TODO: 0 = 4x slow, 64 = 2x slow, 128 = normal, 192 = 2x fast, 255 = 4x fast
-  uint32_t wait = currentFrameDelay * 2 - seg.speed * currentFrameDelay / 128;
-
-  // TODO consider handling this on FX level with a different frametime, but that would cause slow gifs to speed up during transitions
-  if (millis() - lastFrameDisplayTime < wait) return IMAGE_ERROR_WAITING;
+  }
 
-  decoder.getSize(&gifWidth, &gifHeight);
+  if (pl->failed) return IMAGE_ERROR_PREV;
 
-  int result = decoder.decodeFrame(false);
-  if (result < 0) { gifDecodeFailed = true; return IMAGE_ERROR_FRAME_DECODE; }
+  if (pl->frameCount) {
+    // speed 0 = half speed, 128 = normal, 255 = full FX FPS
+    // TODO: 0 = 4x slow, 64 = 2x slow, 128 = normal, 192 = 2x fast, 255 = 4x fast
+    const uint32_t delay = pl->delays[pl->streaming ? 0 : pl->current];
+    const uint32_t wait  = delay * 2 - seg.speed * delay / 128;
+
+    // TODO consider handling this on FX level with a different frametime, but that would cause slow gifs to speed up during transitions
+    const unsigned long elapsed = millis() - pl->lastFrameTime;
+    if (elapsed < wait) return IMAGE_ERROR_WAITING;
+    pl->lastFrameTime = elapsed < 2 * wait ? pl->lastFrameTime + wait : millis(); // if last frame was longer than intended, compensate
+  } else pl->lastFrameTime = millis();
+
+  if (pl->complete) pl->current = (pl->current + 1) % pl->frameCount;
+  else {
+    byte result = acquireDecoder(*pl);
+    if (result == IMAGE_ERROR_WAITING) return result;
+    if (result == IMAGE_ERROR_NONE) result = decodeNextFrame(*pl);
+    if (result != IMAGE_ERROR_NONE) {
+      if (decoderOwner == pl) releaseDecoder();
+      pl->failed = true;
+      return result;
+    }
+  }
 
-  currentFrameDelay = decoder.getFrameDelay_ms();
-  unsigned long tooSlowBy = (millis() - lastFrameDisplayTime) - wait; // if last frame was longer than intended, compensate
-  currentFrameDelay = tooSlowBy > currentFrameDelay ? 0 : currentFrameDelay - tooSlowBy;
-  lastFrameDisplayTime = millis();
+  // copy (pre-scaled) frame to segment
+  const uint8_t *pixel = pl->frames + (pl->streaming ? 0 : pl->current) * width * height * 3;
+  for (unsigned y = 0; y < height; y++) {
+    for (unsigned x = 0; x < width; x++, pixel += 3) seg.setPixelColorXY(x, y, RGBW32(pixel[0], pixel[1], pixel[2], 0));
+  }
 
   return IMAGE_ERROR_NONE;
+  #endif
 }
 
 void endImagePlayback(Segment *seg) {
+  #ifdef WLED_ENABLE_FSEQ
+  endFseqPlayback(seg);
+  #endif
+  #ifdef WLED_ENABLE_GIF
   DEBUG_PRINTLN(F("Image playback end called"));
-  if (!activeSeg || activeSeg != seg) return;
-  if (file) file.close();
-  decoder.dealloc();
-  gifDecodeFailed = false;
-  activeSeg = nullptr;
-  lastFilename[1] = '\0';
-  DEBUG_PRINTLN(F("Image playback ended"));
+  for (image_player_t &pl : players) if (pl.seg == seg) {
+    releasePlayer(pl);
+    DEBUG_PRINTLN(F("Image playback ended"));
+  }
+  #endif
 }
 
 #endif
\ No newline at end of file
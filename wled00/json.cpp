@@ -701,6 +701,18 @@ void serializeInfo(JsonObject root)
   leds[F("pwr")] = BusManager::currentMilliamps();
   leds["fps"] = strip.getFps();
   leds[F("maxpwr")] = BusManager::currentMilliamps()>0 ? BusManager::ablMilliampsMax() : 0;
+  // ABL estimate of each bus (mA) and of each PSU group in use
+  JsonArray bpwr = leds.createNestedArray(F("bpwr"));
+  for (size_t b = 0; b < BusManager::getNumBusses(); b++) bpwr.add(BusManager::getBus(b)->getUsedCurrent());
+  JsonArray psu;
+  for (unsigned g = 1; g <= WLED_MAX_PSU_GROUPS; g++) {
+    if (!BusManager::psuMilliampsMax(g)) continue;
+    if (psu.isNull()) psu = leds.createNestedArray(F("psu"));
+    JsonObject grp = psu.createNestedObject();
+    grp["id"]        = g;
+    grp[F("pwr")]    = BusManager::psuMilliamps(g);
+    grp[F("maxpwr")] = BusManager::psuMilliampsMax(g);
+  }
   leds[F("maxseg")] = WS2812FX::getMaxSegments();
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
   //leds[F("seglock")] = false; //might be used in the future to prevent modifications to segment config
@@ -730,6 +742,33 @@ void serializeInfo(JsonObject root)
   leds[F("wv")]   = totalLC & 0x02;     // deprecated, true if white slider should be displayed for any segment
   leds["cct"]     = totalLC & 0x04;     // deprecated, use info.leds.lc
 
+  #ifdef WLED_ENABLE_PERF
+  // output timing per bus (times in us per frame, utilisation in %), last complete profiler window
+  JsonObject out = leds.createNestedObject(F("out"));
+  JsonArray outBus = out.createNestedArray(F("bus"));
+  unsigned maxUtil = 0, busTime = 0, window = 0;
+  for (size_t b = 0; b < BusManager::getNumBusses(); b++) {
+    Bus *bus = BusManager::getBus(b);
+    const bool complete = bus->lastTiming().frames;
+    const bus_timing_t &bt = complete ? bus->lastTiming() : bus->timing();
+    window = complete ? WLED_PERF_WINDOW : max(1UL, millis() - perfData.windowStart);
+    const unsigned wire = bus->getWireTime();
+    const unsigned util = (uint64_t)wire * bt.shown / (window * 10);
+    if (util > maxUtil) maxUtil = util;
+    busTime += bt.paint + bt.show;
+    JsonObject ob = outBus.createNestedObject();
+    ob[F("paint")] = bt.frames ? bt.paint / bt.frames : 0; // painting is done on every frame
+    ob[F("wait")]  = bt.shown ? bt.wait / bt.shown : 0;
+    ob[F("show")]  = bt.shown ? bt.show / bt.shown : 0;
+    ob[F("wire")]  = wire;
+    ob["fps"]      = bt.shown * 1000 / window;
+    ob[F("util")]  = util;
+  }
+  out[F("win")]  = window;
+  out[F("util")] = maxUtil;                         // busiest output (buses transmit concurrently)
+  out[F("cpu")]  = window ? busTime / (window * 10) : 0; // share of time spent painting & starting transfers
+  #endif
+
   #ifdef WLED_DEBUG
   JsonArray i2c = root.createNestedArray(F("i2c"));
   i2c.add(i2c_sda);
@@ -1091,10 +1130,158 @@ class LockedJsonResponse: public AsyncJsonResponse {
   virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
 };
 
+#ifdef WLED_ENABLE_PERF
+static void serializePerfStat(JsonObject root, const perf_stat_t &stat)
+{
+  // report last complete window, or current window if none has completed yet
+  if (stat.lCnt) {
+    root[F("min")] = stat.lMin;
+    root[F("avg")] = stat.lAvg;
+    root[F("max")] = stat.lMax;
+    root["n"]      = stat.lCnt;
+  } else {
+    root[F("min")] = stat.min;
+    root[F("avg")] = stat.cnt ? stat.sum / stat.cnt : 0;
+    root[F("max")] = stat.max;
+    root["n"]      = stat.cnt;
+  }
+}
+
+// effect profiler data (times in us)
+void serializePerf(JsonObject root)
+{
+  root[F("win")] = WLED_PERF_WINDOW;
+  root[F("fps")] = strip.getFps();
+  root[F("ft")]  = strip.getFrameTime() * 1000; // frame budget (us)
+  root[F("thr")] = strip.getThrottle();          // frame budget scheduler level
+  serializePerfStat(root.createNestedObject(F("service")), perfData.service);
+  serializePerfStat(root.createNestedObject(F("show")),    perfData.show);
+  serializePerfStat(root.createNestedObject(F("bus")),     perfData.bus);
+
+  JsonObject mem = root.createNestedObject(F("mem"));
+  mem[F("used")] = Segment::getUsedSegmentData();
+  mem[F("peak")] = perfData.dataPeak;
+  mem[F("max")]  = MAX_SEGMENT_DATA;
+
+  JsonArray segs = root.createNestedArray(F("seg"));
+  for (size_t s = 0; s < strip.getSegmentsNum() && s < MAX_NUM_SEGMENTS; s++) {
+    const Segment &sg = strip.getSegment(s);
+    if (!sg.isActive()) continue;
+    const perf_segment_t &ps = perfData.seg[s];
+    JsonObject seg = segs.createNestedObject();
+    seg["id"]        = s;
+    seg["fx"]        = ps.mode;
+    seg[F("len")]    = sg.length();
+    seg[F("cost")]   = sg.cost();
+    seg[F("data")]   = sg.dataSize();
+    seg[F("dreq")]   = ps.dataLen;
+    seg[F("dfail")]  = ps.dataFail;
+    serializePerfStat(seg.createNestedObject(F("run")),   ps.fx);
+    serializePerfStat(seg.createNestedObject(F("old")),   ps.fxOld);
+    serializePerfStat(seg.createNestedObject(F("blend")), ps.blend);
+  }
+
+  JsonArray modes = root.createNestedArray(F("fx"));
+  for (const perf_mode_t &pm : perfData.mode) {
+    if (!pm.lastUsed) continue;
+    JsonObject mode = modes.createNestedObject();
+    mode["id"] = pm.id;
+    serializePerfStat(mode, pm.fx);
+  }
+}
+#endif
+
+// bus topology planner: /json/plan?n=<LEDs>&pins=<GPIO,GPIO,...>[&fps=<target>][&type=<LED type>][&order=<color order>]
+// proposed layout ("ins") uses cfg.json format and can be POSTed to /json/cfg ({"hw":{"led":{"prl":..,"ins":[..]}}})
+// single pin digital buses are replaced with proposed ones, other buses (2 pin, PWM, virtual) are kept
+static void serializeBusPlan(JsonObject root, AsyncWebServerRequest* request)
+{
+  // by default plan the LEDs of current single pin digital buses, starting where the first of them starts
+  unsigned planned = 0;
+  unsigned first = UINT_MAX;
+  for (size_t b = 0; b < BusManager::getNumBusses(); b++) {
+    const Bus *bus = BusManager::getBus(b);
+    if (!bus->isDigital() || bus->is2Pin()) continue;
+    planned += bus->getLength();
+    first = min(first, (unsigned)bus->getStart());
+  }
+  const unsigned leds = request->hasArg("n") ? request->arg("n").toInt() : planned;
+  const unsigned firstLed = first == UINT_MAX ? 0 : first;
+  const unsigned targetFps = request->hasArg(F("fps")) ? request->arg(F("fps")).toInt() : strip.getTargetFps();
+  const uint8_t type = request->hasArg(F("type")) ? request->arg(F("type")).toInt() : DEFAULT_LED_TYPE;
+  const uint8_t order = request->arg(F("order")).toInt();
+
+  // usable pins: not used or used by current LED outputs (which will be released)
+  uint8_t pins[WLED_MAX_DIGITAL_CHANNELS];
+  unsigned numPins = 0;
+  const String &pinArg = request->arg(F("pins"));
+  for (int i = 0; i >= 0 && i < (int)pinArg.length() && numPins < WLED_MAX_DIGITAL_CHANNELS; ) {
+    int next = pinArg.indexOf(',', i);
+    int p = pinArg.substring(i, next < 0 ? pinArg.length() : next).toInt();
+    if (PinManager::isPinOk(p) && (!PinManager::isPinAllocated(p) || PinManager::getPinOwner(p) == PinOwner::BusDigital)) pins[numPins++] = p;
+    i = next < 0 ? next : next + 1;
+  }
+
+  bool parallel;
+  const unsigned outputs = BusManager::planOutputs(leds, type, numPins, targetFps, parallel);
+  const unsigned perBus  = outputs ? (leds + outputs - 1) / outputs : 0;
+  const unsigned wire    = outputs ? BusDigital::wireTime(type, type == TYPE_WS2812_1CH_X3 ? NUM_ICS_WS2812_1CH_3X(perBus) : perBus) : 0;
+  const unsigned fps     = wire ? 1000000U / wire : 0;
+  root["n"]         = leds;
+  root["start"]     = firstLed;
+  root["type"]      = type;
+  root[F("target")] = targetFps;
+  root[F("pins")]   = numPins;
+  root[F("out")]    = outputs;
+  root[F("prl")]    = parallel;
+  root[F("wire")]   = wire; // us per frame (longest output)
+  root["fps"]       = fps;  // maximum refresh rate outputs allow (effects & CPU may limit it further)
+  root["ok"]        = outputs && (!targetFps || fps >= targetFps);
+
+  // outputs drive consecutive parts of the strip, so no ledmap is needed
+  // this request is read-only: "ins" is a complete bus list in cfg.json format, to apply it POST {"hw":{"led":{"prl":..,"ins":[..]}}} to /json/cfg
+  JsonArray ins = root.createNestedArray("ins");
+  for (unsigned o = 0, start = 0; o < outputs; o++, start += perBus) {
+    const unsigned len = min(perBus, leds - start);
+    JsonObject bus = ins.createNestedObject();
+    bus["start"]     = firstLed + start;
+    bus["len"]       = len;
+    bus.createNestedArray("pin").add(pins[o]);
+    bus["type"]      = type;
+    bus[F("order")]  = order;
+    bus[F("ledma")]  = LED_MILLIAMPS_DEFAULT;
+    bus[F("maxpwr")] = leds ? (BusManager::ablMilliampsMax() * len) / leds : 0;
+  }
+  // other buses are kept as they are
+  for (size_t b = 0; outputs && b < BusManager::getNumBusses(); b++) {
+    const Bus *bus = BusManager::getBus(b);
+    if (bus->isDigital() && !bus->is2Pin()) continue; // replaced by plan
+    JsonObject cfg = ins.createNestedObject();
+    cfg["start"] = bus->getStart();
+    cfg["len"]   = bus->getLength();
+    JsonArray cfgPins = cfg.createNestedArray("pin");
+    uint8_t busPins[5];
+    uint8_t nPins = bus->getPins(busPins);
+    for (int i = 0; i < nPins; i++) cfgPins.add(busPins[i]);
+    cfg[F("order")]  = bus->getColorOrder();
+    cfg["rev"]       = bus->isReversed();
+    cfg[F("skip")]   = bus->skippedLeds();
+    cfg["type"]      = bus->getType() & 0x7F;
+    cfg["ref"]       = bus->isOffRefreshRequired();
+    cfg[F("rgbwm")]  = bus->getAutoWhiteMode();
+    cfg[F("freq")]   = bus->getFrequency();
+    cfg[F("maxpwr")] = bus->getMaxCurrent();
+    cfg[F("ledma")]  = bus->getLEDCurrent();
+    cfg[F("fps")]    = bus->getMaxFps();
+    cfg[F("pm")]     = bus->getPowerModel();
+    cfg[F("psu")]    = bus->getPsu();
+  }
+}
+
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
-    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config
+    all, state, info, state_info, nodes, effects, palettes, fxdata, networks, config, perf, plan
   };
   json_target subJson = json_target::all;
 
@@ -1108,6 +1295,10 @@ void serveJson(AsyncWebServerRequest* request)
   else if (url.indexOf(F("fxda"))  > 0) subJson = json_target::fxdata;
   else if (url.indexOf(F("net"))   > 0) subJson = json_target::networks;
   else if (url.indexOf(F("cfg"))   > 0) subJson = json_target::config;
+  #ifdef WLED_ENABLE_PERF
+  else if (url.indexOf(F("perf"))  > 0) subJson = json_target::perf;
+  #endif
+  else if (url.indexOf(F("plan"))  > 0) subJson = json_target::plan;
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
@@ -1151,6 +1342,12 @@ void serveJson(AsyncWebServerRequest* request)
       serializeNetworks(lDoc); break;
     case json_target::config:
       serializeConfig(lDoc); break;
+    #ifdef WLED_ENABLE_PERF
+    case json_target::perf:
+      serializePerf(lDoc); break;
+    #endif
+    case json_target::plan:
+      serializeBusPlan(lDoc, request); break;
     case json_target::state_info:
     case json_target::all:
       JsonObject state = lDoc.createNestedObject("state");
@@ -1217,7 +1414,15 @@ bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient)
     r = scale8(qadd8(w, r), strip.getBrightness()); //R, add white channel to RGB channels as a simple RGBW -> RGB map
     g = scale8(qadd8(w, g), strip.getBrightness()); //G
     b = scale8(qadd8(w, b), strip.getBrightness()); //B
-    buf += sprintf_P(buf, PSTR("\"%06X\","), RGBW32(r,g,b,0));
+    // faster than sprintf_P("\"%06X\",")
+    const uint8_t ch[3] = {r, g, b};
+    *buf++ = '"';
+    for (unsigned k = 0; k < 3; k++) {
+      *buf++ = "0123456789ABCDEF"[ch[k] >> 4];
+      *buf++ = "0123456789ABCDEF"[ch[k] & 0x0F];
+    }
+    *buf++ = '"';
+    *buf++ = ',';
   }
   buf--;  // remove last comma
   buf += sprintf_P(buf, PSTR("],\"n\":%d"), n);
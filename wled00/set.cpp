@@ -138,13 +138,17 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       }
     }
 
-    unsigned colorOrder, type, skip, awmode, channelSwap, maPerLed;
+    unsigned colorOrder, type, skip, awmode, channelSwap, maPerLed, powerModel, psuGroup;
     unsigned length, start, maMax;
     uint8_t pins[5] = {255, 255, 255, 255, 255};
 
     // this will set global ABL max current used when per-port ABL is not used
     unsigned ablMilliampsMax = request->arg(F("MA")).toInt();
     BusManager::setMilliampsMax(ablMilliampsMax);
+    for (unsigned g = 1; g <= WLED_MAX_PSU_GROUPS; g++) {
+      char pb[4] = "PB"; pb[2] = '0'+g; pb[3] = 0; //PSU group budget
+      BusManager::setPsuMilliampsMax(g, request->hasArg(F("ABL")) ? request->arg(pb).toInt() : 0);
+    }
 
     strip.autoSegments = request->hasArg(F("MS"));
     strip.correctWB = request->hasArg(F("CCT"));
@@ -174,6 +178,9 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       char sp[4] = "SP"; sp[2] = offset+s; sp[3] = 0; //bus clock speed (DotStar & PWM)
       char la[4] = "LA"; la[2] = offset+s; la[3] = 0; //LED mA
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max mA
+      char fp[4] = "FP"; fp[2] = offset+s; fp[3] = 0; //max FPS
+      char pm[4] = "PM"; pm[2] = offset+s; pm[3] = 0; //power model
+      char pg[4] = "PG"; pg[2] = offset+s; pg[3] = 0; //PSU group
       if (!request->hasArg(lp)) {
         DEBUG_PRINTF_P(PSTR("# of buses: %d\n"), s+1);
         break;
@@ -219,14 +226,20 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       if (Bus::isOnOff(type) || Bus::isPWM(type) || Bus::isVirtual(type)) { // analog and virtual
         maPerLed = 0;
         maMax = 0;
+        powerModel = POWER_MODEL_LINEAR;
+        psuGroup = 0;
       } else {
         maPerLed = request->arg(la).toInt();
         maMax = request->arg(ma).toInt() * request->hasArg(F("PPL")); // if PP-ABL is disabled maMax (per bus) must be 0
+        powerModel = request->arg(pm).toInt();
+        if (powerModel > POWER_MODEL_RGBW_FULL) powerModel = POWER_MODEL_LINEAR; // unknown model
+        psuGroup = min(WLED_MAX_PSU_GROUPS, max(0, (int)request->arg(pg).toInt()));
       }
       type |= request->hasArg(rf) << 7; // off refresh override
       // actual finalization is done in WLED::loop() (removing old busses and adding new)
       // this may happen even before this loop is finished so we do "doInitBusses" after the loop
-      busConfigs.emplace_back(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freq, maPerLed, maMax);
+      unsigned maxFps = min(255, max(0, (int)request->arg(fp).toInt()));
+      busConfigs.emplace_back(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freq, maPerLed, maMax, maxFps, powerModel, psuGroup);
       busesChanged = true;
     }
     //doInitBusses = busesChanged; // we will do that below to ensure all input data is processed
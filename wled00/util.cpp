@@ -528,15 +528,18 @@ um_data_t* simulateSound(uint8_t simulationId)
 }
 
 static const char s_ledmap_tmpl[] PROGMEM = "ledmap%d.json";
-// enumerate all ledmapX.json files on FS and extract ledmap names if existing
+static const char s_ledmap_bin_tmpl[] PROGMEM = "ledmap%d.bin";
+// enumerate all ledmapX.json and ledmapX.bin files on FS and extract ledmap names if existing
 void enumerateLedmaps() {
   StaticJsonDocument<64> filter;
   filter["n"] = true;
   ledMaps = 1;
   for (size_t i=1; i<WLED_MAX_LEDMAPS; i++) {
     char fileName[33] = "/";
-    sprintf_P(fileName+1, s_ledmap_tmpl, i);
-    bool isFile = WLED_FS.exists(fileName);
+    sprintf_P(fileName+1, s_ledmap_bin_tmpl, i);
+    bool isBinary = WLED_FS.exists(fileName);
+    if (!isBinary) sprintf_P(fileName+1, s_ledmap_tmpl, i);
+    bool isFile = isBinary || WLED_FS.exists(fileName);
 
     #ifndef ESP8266
     if (ledmapNames[i-1]) { //clear old name
@@ -549,7 +552,23 @@ void enumerateLedmaps() {
       ledMaps |= 1 << i;
 
       #ifndef ESP8266
-      if (requestJSONBufferLock(21)) {
+      if (isBinary) {
+        // name (if any) follows the header, it is not null terminated
+        File f = WLED_FS.open(fileName, "r");
+        ledmap_bin_t hdr;
+        if (f && f.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr) && hdr.magic == LEDMAP_BIN_MAGIC && hdr.nameLen > 0 && hdr.nameLen < 33) {
+          ledmapNames[i-1] = static_cast<char*>(malloc(hdr.nameLen+1));
+          if (ledmapNames[i-1]) {
+            size_t len = f.read(reinterpret_cast<uint8_t*>(ledmapNames[i-1]), hdr.nameLen);
+            ledmapNames[i-1][len] = '\0';
+          }
+        }
+        if (f) f.close();
+        if (!ledmapNames[i-1]) {
+          ledmapNames[i-1] = static_cast<char*>(malloc(strlen(fileName))); // without leading slash
+          if (ledmapNames[i-1]) strcpy(ledmapNames[i-1], fileName+1);
+        }
+      } else if (requestJSONBufferLock(21)) {
         if (readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
           size_t len = 0;
           JsonObject root = pDoc->as<JsonObject>();
@@ -54,6 +54,16 @@
 // filesystem specific debugging
 //#define WLED_DEBUG_FS
 
+// effect profiler (per segment/effect execution times served on /json/perf, per bus output timing in info.leds.out)
+//#define WLED_ENABLE_PERF
+
+// memory only "loopback" LED bus type for testing & benchmarking output pipeline (see BusLoopback)
+//#define WLED_ENABLE_LOOPBACK_BUS
+
+// digital LED buses apply gamma & brightness with 16 bit precision and use temporal dithering (smoother low brightness fades)
+// WLED_DITHER_BITS (default 3) sets how many fractional bits are dithered (cycle of 2^bits frames)
+//#define WLED_ENABLE_DITHERING
+
 #ifndef WLED_WATCHDOG_TIMEOUT
   // 3 seconds should be enough to detect a lockup
   // define WLED_WATCHDOG_TIMEOUT=0 to disable watchdog, default
@@ -15,6 +15,7 @@
  */
 #include "wled.h"
 
+#ifndef PIO_UNIT_TESTING // unit tests (test/) provide their own setup() & loop()
 void setup() {
   WLED::instance().setup();
 }
@@ -22,3 +23,4 @@ void setup() {
 void loop() {
   WLED::instance().loop();
 }
+#endif
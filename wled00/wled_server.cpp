@@ -177,6 +177,12 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
       request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("Configuration restore successful.\nRebooting..."));
     } else {
       if (filename.indexOf(F("palette")) >= 0 && filename.indexOf(F(".json")) >= 0) loadCustomPalettes();
+      if (filename.indexOf(F("ledmap")) >= 0 && filename.endsWith(F(".json"))) {
+        // binary ledmap takes precedence so remove it to make the uploaded JSON ledmap effective
+        String binName = filename.substring(0, filename.length()-5) + F(".bin");
+        if (binName.charAt(0) != '/') binName = '/' + binName;
+        if (WLED_FS.exists(binName)) WLED_FS.remove(binName);
+      }
       request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("File Uploaded!"));
     }
     cacheInvalidate++;
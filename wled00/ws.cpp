@@ -10,6 +10,61 @@ unsigned long wsLastLiveTime = 0;
 //uint8_t* wsFrameBuffer = nullptr;
 
 #define WS_LIVE_INTERVAL 40
+#define WS_LIVE_MAX_FPS  60
+#define WS_LIVE_KEYFRAME 100  // send full frame every n-th frame (or when geometry changes)
+
+/*
+ * Live view protocol version 3 (requested with {"lv":{"fps":n}}), binary, little endian
+ *  [0]    'L'
+ *  [1]    3 (version)
+ *  [2]    flags: bit0 keyframe, bit1 white channel included, bit2 segment bounds included
+ *  [3]    frame sequence number
+ *  [4..5] width, [6..7] height (height is 1 for 1D set-ups)
+ *  [8]    current strip brightness (pixel values are not brightness scaled)
+ *  if segment bounds: [n] count followed by count x (start, stop, startY, stopY) as uint16
+ *  followed by delta/RLE encoded pixels, each op byte has count-1 in lower 6 bits:
+ *  0b00xxxxxx skip count pixels (unchanged since previous frame)
+ *  0b01xxxxxx repeat following single colour count times
+ *  0b10xxxxxx count literal colours follow
+ *  colours are R,G,B (+W if white channel is included)
+ */
+static struct {
+  uint32_t *prev;      // last frame sent to live client (for delta encoding)
+  size_t    len;       // size of prev
+  uint16_t  interval;  // ms between frames
+  uint8_t   seq;       // frame sequence number
+  uint8_t   bri;       // brightness of last sent frame
+  bool      keyframe;  // next frame must be a key frame
+  // live view request from wsEvent() (async TCP task), history is only (re)allocated by handleWs() in loop task
+  volatile uint16_t reqInterval;
+  volatile bool     reqDelta;
+  volatile bool     resetPending;
+} wsLive = {nullptr, 0, WS_LIVE_INTERVAL, 0, 0, true, WS_LIVE_INTERVAL, false, false};
+
+// called from async TCP task: only store the request
+static void wsLiveRequest(bool delta, uint16_t interval = WS_LIVE_INTERVAL) {
+  wsLive.reqDelta = delta;
+  wsLive.reqInterval = interval;
+  wsLive.resetPending = true;
+}
+
+// called from loop task: apply pending request (free or allocate history)
+static void wsLiveReset() {
+  if (!wsLive.resetPending) return;
+  wsLive.resetPending = false;
+  p_free(wsLive.prev);
+  wsLive.prev = nullptr;
+  wsLive.len = 0;
+  wsLive.interval = wsLive.reqInterval;
+  if (!wsLive.reqDelta) return;
+  size_t len = strip.getLengthTotal();
+  #ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) len = Segment::maxWidth*Segment::maxHeight;
+  #endif
+  wsLive.prev = static_cast<uint32_t*>(p_malloc(len * sizeof(uint32_t))); // if allocation fails legacy protocol is used
+  if (wsLive.prev) wsLive.len = len;
+  wsLive.keyframe = true;
+}
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
@@ -19,7 +74,7 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
-    if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    if (client->id() == wsLiveClientId) { wsLiveClientId = 0; wsLiveRequest(false); }
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
@@ -51,7 +106,16 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           //if the received value is just "{"v":true}", send only to this client
           verboseResponse = true;
         } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
+          JsonObject lv = root["lv"];
+          if (!lv.isNull()) {
+            // full resolution delta encoded live view (protocol v3)
+            unsigned fps = constrain(lv["fps"] | 25, 1, WS_LIVE_MAX_FPS);
+            wsLiveRequest(true, 1000 / fps);
+            wsLiveClientId = client->id();
+          } else {
+            wsLiveRequest(false);
+            wsLiveClientId = root["lv"] ? client->id() : 0;
+          }
         } else {
           verboseResponse = deserializeState(root);
         }
@@ -160,10 +224,115 @@ void sendDataWs(AsyncWebSocketClient * client)
   releaseJSONBufferLock();
 }
 
+// appends a delta/RLE op (and its colours) to out (if not nullptr) and returns number of bytes used
+static size_t wsLiveOp(uint8_t *out, unsigned op, unsigned count, const uint32_t *cols, bool white) {
+  size_t pos = 0;
+  while (count) {
+    unsigned n = count > 64 ? 64 : count;
+    unsigned nCols = op == 0 ? 0 : op == 1 ? 1 : n;
+    if (out) {
+      out[pos] = (op << 6) | (n - 1);
+      uint8_t *p = out + pos + 1;
+      for (unsigned i = 0; i < nCols; i++) {
+        *p++ = R(cols[i]); *p++ = G(cols[i]); *p++ = B(cols[i]);
+        if (white) *p++ = W(cols[i]);
+      }
+    }
+    pos += 1 + nCols * (3 + white);
+    if (op == 2) cols += n;
+    count -= n;
+  }
+  return pos;
+}
+
+// encodes pixels against previous frame; if out is nullptr only the encoded size is returned
+static size_t wsLiveEncode(uint8_t *out, const uint32_t *px, size_t len, bool key, bool white) {
+  size_t pos = 0;
+  size_t i = 0;
+  while (i < len) {
+    size_t j = i + 1;
+    if (!key && px[i] == wsLive.prev[i]) {
+      while (j < len && px[j] == wsLive.prev[j]) j++;
+      pos += wsLiveOp(out ? out + pos : nullptr, 0, j - i, nullptr, white);
+    } else if (j < len && px[j] == px[i]) {
+      while (j < len && px[j] == px[i]) j++;
+      pos += wsLiveOp(out ? out + pos : nullptr, 1, j - i, &px[i], white);
+    } else {
+      // literal run ends where an unchanged pixel or a run of 3 equal pixels begins
+      while (j < len && (key || px[j] != wsLive.prev[j]) && !(j+2 < len && px[j] == px[j+1] && px[j] == px[j+2])) j++;
+      pos += wsLiveOp(out ? out + pos : nullptr, 2, j - i, &px[i], white);
+    }
+    i = j;
+  }
+  return pos;
+}
+
+static bool sendLiveLedsWsDelta(AsyncWebSocketClient *wsc)
+{
+  size_t used = strip.getLengthTotal();
+  unsigned width = used, height = 1;
+#ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) {
+    width  = Segment::maxWidth;
+    height = Segment::maxHeight;
+    used   = width * height;
+  }
+#endif
+  if (used > wsLive.len) { // geometry changed, re-allocate history
+    uint32_t *prev = static_cast<uint32_t*>(p_realloc(wsLive.prev, used * sizeof(uint32_t)));
+    if (!prev) return false;
+    wsLive.prev = prev;
+    wsLive.len  = used;
+    wsLive.keyframe = true;
+  }
+  const uint32_t *px = strip.getPixels();
+  if (!px) return false;
+  const bool white = strip.hasWhiteChannel();
+  const bool key   = wsLive.keyframe || (wsLive.seq % WS_LIVE_KEYFRAME) == 0;
+  const uint8_t sBri = bri ? strip.getBrightness() : 0;
+  const size_t payload = wsLiveEncode(nullptr, px, used, key, white);
+  // nothing changed (only skip ops) and brightness is the same, no need to send anything
+  if (!key && sBri == wsLive.bri && payload <= (used + 63) / 64) return true;
+
+  unsigned nSegs = key ? strip.getActiveSegmentsNum() : 0;
+  size_t bufSize = 9 + (key ? 1 + 8 * nSegs : 0) + payload;
+  AsyncWebSocketBuffer wsBuf(bufSize);
+  if (!wsBuf) return false; //out of memory
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(wsBuf.data());
+  if (!buffer) return false; //out of memory
+  buffer[0] = 'L';
+  buffer[1] = 3; //version
+  buffer[2] = key | (white << 1) | (key << 2);
+  buffer[3] = wsLive.seq;
+  buffer[4] = width & 0xFF;  buffer[5] = width >> 8;
+  buffer[6] = height & 0xFF; buffer[7] = height >> 8;
+  buffer[8] = sBri;
+  size_t pos = 9;
+  if (key) {
+    buffer[pos++] = nSegs;
+    const Segment *segs = strip.getSegments();
+    for (size_t s = 0, n = 0; s < strip.getSegmentsNum() && n < nSegs; s++) {
+      if (!segs[s].isActive()) continue;
+      const uint16_t bounds[4] = {segs[s].start, segs[s].stop, segs[s].startY, segs[s].stopY};
+      for (unsigned b = 0; b < 4; b++) { buffer[pos++] = bounds[b] & 0xFF; buffer[pos++] = bounds[b] >> 8; }
+      n++;
+    }
+  }
+  wsLiveEncode(buffer + pos, px, used, key, white);
+  memcpy(wsLive.prev, px, used * sizeof(uint32_t));
+  wsLive.keyframe = false;
+  wsLive.bri = sBri;
+  wsLive.seq++;
+
+  wsc->binary(std::move(wsBuf));
+  return true;
+}
+
 bool sendLiveLedsWs(uint32_t wsClient)
 {
   AsyncWebSocketClient * wsc = ws.client(wsClient);
   if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
+  if (wsLive.prev) return sendLiveLedsWsDelta(wsc);
 
   size_t used = strip.getLengthTotal();
 #ifdef ESP8266
@@ -221,7 +390,8 @@ bool sendLiveLedsWs(uint32_t wsClient)
 
 void handleWs()
 {
-  if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
+  wsLiveReset(); // apply live view request received by wsEvent()
+  if (millis() - wsLastLiveTime > wsLive.interval)
   {
     #ifdef ESP8266
     ws.cleanupClients(3);
@@ -311,6 +311,9 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       char sp[4] = "SP"; sp[2] = offset+s; sp[3] = 0; //bus clock speed
       char la[4] = "LA"; la[2] = offset+s; la[3] = 0; //LED current
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max per-port PSU current
+      char fp[4] = "FP"; fp[2] = offset+s; fp[3] = 0; //max FPS
+      char pm[4] = "PM"; pm[2] = offset+s; pm[3] = 0; //power model
+      char pg[4] = "PG"; pg[2] = offset+s; pg[3] = 0; //PSU group
       settingsScript.print(F("addLEDs(1);"));
       uint8_t pins[5];
       int nPins = bus->getPins(pins);
@@ -327,6 +330,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       printSetFormCheckbox(settingsScript,rf,bus->isOffRefreshRequired());
       printSetFormValue(settingsScript,aw,bus->getAutoWhiteMode());
       printSetFormValue(settingsScript,wo,bus->getColorOrder() >> 4);
+      printSetFormValue(settingsScript,fp,bus->getMaxFps());
       unsigned speed = bus->getFrequency();
       if (bus->isPWM()) {
         switch (speed) {
@@ -350,10 +354,18 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       printSetFormValue(settingsScript,sp,speed);
       printSetFormValue(settingsScript,la,bus->getLEDCurrent());
       printSetFormValue(settingsScript,ma,bus->getMaxCurrent());
+      printSetFormValue(settingsScript,pm,bus->getPowerModel());
+      printSetFormValue(settingsScript,pg,bus->getPsu());
       sumMa += bus->getMaxCurrent();
     }
+    unsigned sumPsu = 0;
+    for (unsigned g = 1; g <= WLED_MAX_PSU_GROUPS; g++) {
+      char pb[4] = "PB"; pb[2] = '0'+g; pb[3] = 0; //PSU group budget
+      printSetFormValue(settingsScript,pb,BusManager::psuMilliampsMax(g));
+      sumPsu += BusManager::psuMilliampsMax(g);
+    }
     printSetFormValue(settingsScript,PSTR("MA"),BusManager::ablMilliampsMax() ? BusManager::ablMilliampsMax() : sumMa);
-    printSetFormCheckbox(settingsScript,PSTR("ABL"),BusManager::ablMilliampsMax() || sumMa > 0);
+    printSetFormCheckbox(settingsScript,PSTR("ABL"),BusManager::ablMilliampsMax() || sumMa > 0 || sumPsu > 0);
     printSetFormCheckbox(settingsScript,PSTR("PPL"),!BusManager::ablMilliampsMax() && sumMa > 0);
 
     settingsScript.printf_P(PSTR("resetCOM(%d);"), WLED_MAX_COLOR_ORDER_MAPPINGS);